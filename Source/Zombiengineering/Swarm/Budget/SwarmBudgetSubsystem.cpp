@@ -0,0 +1,120 @@
+#include "SwarmBudgetSubsystem.h"
+
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSwarmBudget, Log, All);
+
+void USwarmBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SetBudget(ESwarmBudget::LOSTrace,     LOSTracesPerFrame);
+	SetBudget(ESwarmBudget::NavReproject, NavReprojectsPerFrame);
+	Refill();
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &USwarmBudgetSubsystem::OnWorldPreActorTick);
+}
+
+void USwarmBudgetSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	Super::Deinitialize();
+}
+
+void USwarmBudgetSubsystem::SetBudget(ESwarmBudget Category, int32 PerFrame)
+{
+	Get(Category).Budget.store(FMath::Max(0, PerFrame), std::memory_order_relaxed);
+}
+
+void USwarmBudgetSubsystem::OnWorldPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+		Refill();
+}
+
+void USwarmBudgetSubsystem::Refill()
+{
+	for (uint8 c = 0; c < uint8(ESwarmBudget::Num); ++c)
+	{
+		FCategory& Cat = Categories[c];
+
+		Cat.Last.Budget = Cat.Budget.load(std::memory_order_relaxed);
+		Cat.Last.Used   = Cat.Used.exchange(0, std::memory_order_relaxed);
+		Cat.Last.Denied = Cat.Denied.exchange(0, std::memory_order_relaxed);
+		Cat.LastLeases  = FMath::Max(1, Cat.Leases.exchange(0, std::memory_order_relaxed));
+
+		Cat.Remaining.store(Cat.Last.Budget, std::memory_order_relaxed);
+		Cat.Spill.store(0, std::memory_order_relaxed);
+
+		UE_CLOG(Cat.Last.Denied > 0, LogSwarmBudget, Verbose, TEXT("Budget %d over-demanded: used %d of %d, denied %d"),
+			c, Cat.Last.Used, Cat.Last.Budget, Cat.Last.Denied);
+	}
+}
+
+int32 USwarmBudgetSubsystem::Take(std::atomic<int32>& Pool, int32 Want)
+{
+	int32 Have = Pool.load(std::memory_order_relaxed);
+	while (Have > 0)
+	{
+		const int32 Got = FMath::Min(Have, Want);
+		if (Pool.compare_exchange_weak(Have, Have - Got, std::memory_order_relaxed))
+			return Got;
+	}
+	return 0;
+}
+
+FSwarmBudgetLease::FSwarmBudgetLease(USwarmBudgetSubsystem* InBudgets, ESwarmBudget InCategory)
+	: Budgets(InBudgets)
+	, Category(InCategory)
+{
+	if (!Budgets)
+		return;
+
+	USwarmBudgetSubsystem::FCategory& Cat = Budgets->Get(Category);
+	Cat.Leases.fetch_add(1, std::memory_order_relaxed);
+	Slice = FMath::Max(1, FMath::DivideAndRoundUp(Cat.Budget.load(std::memory_order_relaxed), Cat.LastLeases));
+}
+
+FSwarmBudgetLease::~FSwarmBudgetLease()
+{
+	if (!Budgets)
+		return;
+
+	USwarmBudgetSubsystem::FCategory& Cat = Budgets->Get(Category);
+	if (Held > 0)
+		Cat.Spill.fetch_add(Held, std::memory_order_relaxed);
+	if (Consumed > 0)
+		Cat.Used.fetch_add(Consumed, std::memory_order_relaxed);
+	if (Denied > 0)
+		Cat.Denied.fetch_add(Denied, std::memory_order_relaxed);
+}
+
+bool FSwarmBudgetLease::Refill()
+{
+	if (!Budgets)
+	{
+		Held = MAX_int32 / 2;
+		return true;
+	}
+
+	USwarmBudgetSubsystem::FCategory& Cat = Budgets->Get(Category);
+	const int32 Batch = FMath::Max(1, Budgets->LeaseBatch);
+
+	if (Taken < Slice)
+	{
+		Held   = USwarmBudgetSubsystem::Take(Cat.Remaining, FMath::Min(Batch, Slice - Taken));
+		Taken += Held;
+		if (Held > 0)
+			return true;
+	}
+
+	// Past our slice: what other chunks handed back first, then whatever is still unclaimed.
+	Held = USwarmBudgetSubsystem::Take(Cat.Spill, Batch);
+	if (Held == 0)
+		Held = USwarmBudgetSubsystem::Take(Cat.Remaining, Batch);
+	if (Held > 0)
+		return true;
+
+	++Denied;
+	return false;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "SwarmBudgetSubsystem.generated.h"
+
+#include <atomic>
+
+enum class ESwarmBudget : uint8
+{
+	LOSTrace,
+	NavReproject,
+
+	Num
+};
+
+// Per-frame work caps shared by every processor, safe to draw from parallel chunks. Each
+// category's tokens are refilled at the start of the frame. Chunks draw through an
+// FSwarmBudgetLease, which takes tokens in small batches up to a fair slice of the budget
+// (budget / leases opened last frame). Tokens a lease doesn't use go to a spill pool; leases
+// past their slice draw from the spill pool, then from tokens no lease has claimed yet. Demand
+// refused for lack of tokens is counted as denied.
+UCLASS()
+class USwarmBudgetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	struct FFrameStats
+	{
+		int32 Budget = 0;
+		int32 Used   = 0;
+		int32 Denied = 0;
+	};
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Runtime override of the per-frame tunables below; takes effect at the next refill.
+	void SetBudget(ESwarmBudget Category, int32 PerFrame);
+
+	FORCEINLINE int32 GetBudget(ESwarmBudget Category) const { return Get(Category).Budget.load(std::memory_order_relaxed); }
+	FORCEINLINE int32 GetUsed(ESwarmBudget Category)   const { return Get(Category).Used.load(std::memory_order_relaxed); }
+	FORCEINLINE int32 GetDenied(ESwarmBudget Category) const { return Get(Category).Denied.load(std::memory_order_relaxed); }
+	FORCEINLINE const FFrameStats& GetLastFrame(ESwarmBudget Category) const { return Get(Category).Last; }
+
+public:
+	UPROPERTY() int32 LOSTracesPerFrame     = 64;
+	UPROPERTY() int32 NavReprojectsPerFrame = 1024;
+	UPROPERTY() int32 LeaseBatch            = 4;
+
+private:
+	friend class FSwarmBudgetLease;
+
+	struct FCategory
+	{
+		std::atomic<int32> Budget{ 0 };
+		std::atomic<int32> Remaining{ 0 };
+		std::atomic<int32> Spill{ 0 };
+		std::atomic<int32> Used{ 0 };
+		std::atomic<int32> Denied{ 0 };
+		std::atomic<int32> Leases{ 0 };
+		int32 LastLeases = 1;
+		FFrameStats Last;
+	};
+
+	FORCEINLINE FCategory&       Get(ESwarmBudget Category)       { return Categories[uint8(Category)]; }
+	FORCEINLINE const FCategory& Get(ESwarmBudget Category) const { return Categories[uint8(Category)]; }
+
+	static int32 Take(std::atomic<int32>& Pool, int32 Want);
+
+	void OnWorldPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void Refill();
+
+	FCategory Categories[uint8(ESwarmBudget::Num)];
+
+	FDelegateHandle PreActorTickHandle;
+};
+
+// One chunk's draw on a budget category. Chunk-local, not thread-safe itself; returns what it
+// didn't use when it goes out of scope. A null subsystem means unbudgeted.
+class FSwarmBudgetLease
+{
+public:
+	FSwarmBudgetLease(USwarmBudgetSubsystem* InBudgets, ESwarmBudget InCategory);
+	~FSwarmBudgetLease();
+
+	FSwarmBudgetLease(const FSwarmBudgetLease&) = delete;
+	FSwarmBudgetLease& operator=(const FSwarmBudgetLease&) = delete;
+
+	FORCEINLINE bool TryConsume()
+	{
+		if (Held == 0 && !Refill())
+			return false;
+		--Held;
+		++Consumed;
+		return true;
+	}
+
+	FORCEINLINE int32 GetConsumed() const { return Consumed; }
+
+private:
+	bool Refill();
+
+	USwarmBudgetSubsystem* Budgets;
+	ESwarmBudget Category;
+
+	int32 Slice    = 0;
+	int32 Taken    = 0;
+	int32 Held     = 0;
+	int32 Consumed = 0;
+	int32 Denied   = 0;
+};
@@ -2,6 +2,9 @@
 
 #include "MassEntityTypes.h"
 #include "CoreMinimal.h"
+#include "WorldCollision.h"
+#include "Swarm/Path/SwarmPathPool.h"
+#include "Swarm/LOD/SwarmLODControllerSubsystem.h"
 
 #include "SwarmTypes.generated.h"
 
@@ -24,16 +27,38 @@ struct FSwarmPathStateFragment : public FMassFragment
 {
 	GENERATED_BODY()
 
-	TSharedPtr<const TArray<FVector>> PointsRef;
+	FSwarmPathHandle PathHandle;
+	int32   NumPathPoints = 0;
 	int32   Index = 0;
 	FVector LastGoal = FVector::ZeroVector;
 	float PathAge         = 0.f;
 	float RepathCooldown  = 0.f;
 	float NoLOSTime       = 0.f;
 	uint8 bHasPath : 1 = 0;
-
-	FORCEINLINE int32 NumPoints() const { return PointsRef ? PointsRef->Num() : 0; }
-	FORCEINLINE const FVector& Point(int32 i) const { return (*PointsRef)[i]; }
+	uint8 bFlowGuided : 1 = 0;
+
+	FORCEINLINE int32 NumPoints() const { return NumPathPoints; }
+
+	// The fragment owns a pool reference on its path while it follows it. Paths change only
+	// through SetPath/ClearPath; USwarmPathReleaseObserver clears it when the agent is destroyed.
+	FORCEINLINE void SetPath(FSwarmPathPool& Pool, FSwarmPathHandle InHandle, int32 InNumPoints)
+	{
+		if (InHandle != PathHandle)
+		{
+			Pool.AddRef(InHandle);
+			Pool.Release(PathHandle);
+		}
+		PathHandle    = InHandle;
+		NumPathPoints = InNumPoints;
+	}
+
+	FORCEINLINE void ClearPath(FSwarmPathPool& Pool)
+	{
+		Pool.Release(PathHandle);
+		PathHandle    = FSwarmPathHandle();
+		NumPathPoints = 0;
+		bHasPath      = false;
+	}
 };
 
 USTRUCT()
@@ -42,7 +67,15 @@ struct FSwarmLOSFragment : public FMassFragment
 	GENERATED_BODY()
 
 	uint8  bHasLOS : 1 = 0;
+	uint8  bTraceQueued : 1 = 0;
 	float  TimeSinceRefresh = 0.f;
+
+	// Queued by perception, issued on the game thread by the trace submit processor.
+	FVector3f TraceStart = FVector3f::ZeroVector;
+	FVector3f TraceEnd   = FVector3f::ZeroVector;
+
+	// Async geometry trace issued last frame, consumed by the next Sense pass.
+	FTraceHandle PendingTrace;
 };
 
 USTRUCT()
@@ -79,9 +112,14 @@ struct FSwarmMovementParamsFragment : public FMassSharedFragment
 	float PathSpreadMinDistance    = 600.f;
 	float PathSpreadMaxDistance    = 3000.f;
 
-	int32 RepathsPerFrameBudget    = 256;
-	int32 LOSChecksPerFrameBudget  = 64;
 	float LOSRefreshSeconds        = 0.35f;
+	float LOSClusterCellSize       = 300.f;
+	float LOSCacheTTL              = 1.0f;
+
+	uint8 bUseFlowField : 1 = 0;
+	uint8 bClusteredLOS : 1 = 1;
+	uint8 bUseVisibilityField : 1 = 1;
+	uint8 bAsyncLOSTraces : 1 = 1;
 };
 
 USTRUCT()
@@ -107,11 +145,29 @@ struct FSwarmProfilerSharedFragment : public FMassSharedFragment
 	double T_Flocking    = 0.0;
 	double T_PathFollow  = 0.0;
 	double T_Integrate   = 0.0;
+	double T_FlowField   = 0.0;
+	double T_VisField    = 0.0;
+	double T_Dormancy    = 0.0;
 
 	uint8  bPrintedHeader : 1 = 0;
 
 	int32 RepathsUsed     = 0;
 	int32 LOSChecksUsed   = 0;
+	int32 LOSShared       = 0;
+	int32 LOSFieldHits    = 0;
+	int32 LOSCacheHits    = 0;
+	int32 LOSCacheMisses  = 0;
+	int32 LOSCacheWaits   = 0;
+
+	int32 PathCacheHits      = 0;
+	int32 PathCacheMisses    = 0;
+	int32 PathCacheEvictions = 0;
+
+	int32 FlowCellsExpanded = 0;
+
+	int32 AgentsDormant = 0;
+	int32 AgentsParked  = 0;
+	int32 AgentsWoken   = 0;
 
 	int32  DirectChaseCount = 0;
 	double AvgPathAgeAccum  = 0.0;
@@ -175,6 +231,77 @@ struct FSwarmUpdatePolicyFragment : public FMassFragment
 	float CooldownScale      = 1.f;
 
 	uint8 SeparationMask  = 0;
-	uint8 FollowMask = 0;
-	uint8 SenseMask  = 0;
+	uint8 Tier            = 0;   // ESwarmLODTier, mirrored by the tier tag below
+};
+
+// Exactly one tier tag per agent, so each archetype (and chunk) holds a single distance tier
+// and stages can decide per chunk instead of per entity. Moved by the update policy.
+USTRUCT()
+struct FSwarmLODNearTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FSwarmLODMidTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FSwarmLODFarTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+// Per-chunk LOD cadence, so decimated stages decide once per chunk. Phase is handed out when
+// the chunk is first seen and kept for the chunk's life, whatever entities come and go.
+// StageMask mirrors the LOD controller's rates for the chunk's tier, refreshed each frame by
+// USwarmLODChunkProcessor.
+USTRUCT()
+struct FSwarmLODChunkFragment : public FMassChunkFragment
+{
+	GENERATED_BODY()
+
+	uint8 StageMask[uint8(ESwarmLODStage::Num)] = {};
+	uint8 Phase         = 0;
+	uint8 bHasPhase : 1 = 0;
+};
+
+// Stages spread over frames by FSwarmRoundRobin, one chunk offset each.
+enum class ESwarmSchedule : uint8
+{
+	UpdatePolicy,
+	Dormancy,
+	PathReplan,
+	Follow,
+	Separation,
+
+	Num
+};
+
+// Offset of the chunk's first agent when a schedule's query lays its chunks end to end,
+// written by FSwarmRoundRobin::Begin each frame.
+USTRUCT()
+struct FSwarmScheduleChunkFragment : public FMassChunkFragment
+{
+	GENERATED_BODY()
+
+	int32 Base[uint8(ESwarmSchedule::Num)] = {};
+};
+
+// Parked agents; excluded from every per-frame stage.
+USTRUCT()
+struct FSwarmDormantTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FSwarmDormancyFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	// Since last woken; an agent isn't parked again before MinAwakeSeconds.
+	float AwakeTime = 0.f;
 };
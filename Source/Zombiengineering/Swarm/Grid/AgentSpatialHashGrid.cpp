@@ -11,14 +11,21 @@ void FAgentSpatialHashGrid::Reset()
 {
 	for (auto& Pair : Grid)
 	{
-		Pair._Value.EntityData.Reset();
+		Pair._Value.EntityData.Empty();
 	}
+	CellArena.Reset();
 }
 
 void FAgentSpatialHashGrid::InsertEntity(const FMassEntityHandle& Entity, const FVector& Location)
 {
 	const int64 CellKey = HashCoord(GetCellCoord2D(Location));
 	FGridCell& Cell = FindOrAddCell(CellKey);
+
+	FSwarmArenaScope ArenaScope(CellArena);
+	if (Cell.EntityData.Max() == 0)
+	{
+		Cell.EntityData.Reserve(8);
+	}
 	Cell.EntityData.Emplace(Entity, Location);
 }
 
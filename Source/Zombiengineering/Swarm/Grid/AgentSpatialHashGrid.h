@@ -9,6 +9,7 @@
 #include "Limits.h"
 
 #include "HashTable/HashTable.h"
+#include "Swarm/Memory/SwarmFrameArena.h"
 
 #ifndef HASHGRID_LIGHT_HASH
 #define HASHGRID_LIGHT_HASH 0
@@ -51,8 +52,7 @@ public:
 
 	struct FGridCell
 	{
-		TArray<FEntityData> EntityData;
-		FGridCell() { EntityData.Reserve(8); }
+		TArray<FEntityData, FSwarmArenaAllocator> EntityData;
 	};
 
 	void Reset();
@@ -131,10 +131,15 @@ public:
 	}
 	int32 EstimateCountAt(const FVector& Location, float Radius, float ZHalfHeight) const;
 
+	FORCEINLINE SIZE_T GetCellBytesUsed()      const { return CellArena.GetBytesUsed(); }
+	FORCEINLINE SIZE_T GetCellHighWaterBytes() const { return CellArena.GetHighWaterBytes(); }
+
 private:
 	const float CellSize;
 	const float InvCellSize;
 
+	FSwarmLinearArena CellArena;
+
 	using FKV = TestHashTable::TKeyValuePair<int64, FGridCell>;
 	TestHashTable::THashTable<int64, FKV, FInt64HashTraits, FUEHashAllocator> Grid;
 
@@ -0,0 +1,137 @@
+#include "SwarmVisibilityFieldSubsystem.h"
+
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Swarm/Grid/SwarmGridSubsystem.h"
+
+void USwarmVisibilityFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Same cells as the agent grid, so one agent cell maps to one visibility cell.
+	if (const USwarmGridSubsystem* GridSS = Collection.InitializeDependency<USwarmGridSubsystem>())
+		CellSize = GridSS->GetCellSize();
+}
+
+void USwarmVisibilityFieldSubsystem::Deinitialize()
+{
+	Reset();
+	WalkCache.Empty();
+	Super::Deinitialize();
+}
+
+void USwarmVisibilityFieldSubsystem::Reset()
+{
+	Vis.Empty();
+	Points.Empty();
+	Pending.Empty();
+	Size   = 0;
+	bValid = false;
+}
+
+void USwarmVisibilityFieldSubsystem::Tick(const FVector& PlayerNavLoc, int32& OutQueries)
+{
+	OutQueries = 0;
+
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData)
+		return;
+
+	const FIntPoint Cell = WorldToCell(PlayerNavLoc);
+	if (!bValid || Cell != PlayerCell)
+		Recentre(Cell, PlayerNavLoc);
+
+	while (Pending.Num() > 0 && OutQueries < QueriesPerTick)
+	{
+		OutQueries += ResolveCell(NavSys, NavData, Pending.Pop(EAllowShrinking::No));
+	}
+}
+
+void USwarmVisibilityFieldSubsystem::Recentre(const FIntPoint& Cell, const FVector& PlayerNavLoc)
+{
+	const int32 Half = FMath::Max(1, HalfExtentCells);
+
+	PlayerCell   = Cell;
+	PlayerTarget = PlayerNavLoc;
+	Size         = 2 * Half + 1;
+	Origin       = Cell - FIntPoint(Half, Half);
+	bValid       = true;
+
+	// Every answer was relative to the old player position.
+	Vis.Init(EVis::Unknown, Size * Size);
+	Points.Init(FVector3f::ZeroVector, Size * Size);
+
+	Pending.Reset();
+	for (int32 r = Half; r >= 0; --r)
+	{
+		for (int32 y = -r; y <= r; ++y)
+		{
+			for (int32 x = -r; x <= r; ++x)
+			{
+				if (FMath::Max(FMath::Abs(x), FMath::Abs(y)) == r)
+					Pending.Add(Cell + FIntPoint(x, y));
+			}
+		}
+	}
+}
+
+const USwarmVisibilityFieldSubsystem::FWalkSample& USwarmVisibilityFieldSubsystem::SampleCell(
+	UNavigationSystemV1* NavSys, const ANavigationData* NavData, const FIntPoint& Cell)
+{
+	const FVector Center((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, PlayerTarget.Z);
+	const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, MaxStepHeight * 2.f);
+
+	FWalkSample S;
+	FNavLocation Out;
+	if (NavSys->ProjectPointToNavigation(Center, Out, Extent, NavData))
+	{
+		S.bWalkable = true;
+		S.Location  = Out.Location;
+	}
+	return WalkCache.Add(Cell, S);
+}
+
+int32 USwarmVisibilityFieldSubsystem::ResolveCell(UNavigationSystemV1* NavSys, const ANavigationData* NavData, const FIntPoint& Cell)
+{
+	int32 Queries = 0;
+	const FWalkSample* S = WalkCache.Find(Cell);
+	if (!S)
+	{
+		S = &SampleCell(NavSys, NavData, Cell);
+		++Queries;
+	}
+
+	// No navmesh to stand on means no agent to answer for; leave it to the trace.
+	if (!S->bWalkable)
+		return Queries;
+
+	const int32 Idx = IndexOf(Cell);
+	FVector Hit;
+	Points[Idx] = FVector3f(S->Location);
+	Vis[Idx]    = NavData->Raycast(S->Location, PlayerTarget, Hit, nullptr) ? EVis::Hidden : EVis::Visible;
+	return Queries + 1;
+}
+
+bool USwarmVisibilityFieldSubsystem::SampleVisibility(const FVector& Pos, bool& bOutVisible) const
+{
+	if (!bValid)
+		return false;
+
+	const int32 Idx = IndexOf(WorldToCell(Pos));
+	if (Idx == INDEX_NONE || Vis[Idx] == EVis::Unknown)
+		return false;
+
+	// Another floor over the same cell, or far enough from the sample that a wall could
+	// run between them; let the caller trace.
+	const FVector3f& S = Points[Idx];
+	if (FMath::Abs(float(Pos.Z) - S.Z) > 2.f * MaxStepHeight)
+		return false;
+	if (FVector2f::DistSquared(FVector2f(Pos), FVector2f(S)) > FMath::Square(MaxSampleOffset))
+		return false;
+
+	bOutVisible = (Vis[Idx] == EVis::Visible);
+	return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SwarmVisibilityFieldSubsystem.generated.h"
+
+class UNavigationSystemV1;
+class ANavigationData;
+
+// Which cells around the player can see the player, so perception reads LOS by lookup instead
+// of tracing per agent. Each cell keeps a navmesh sample point, projected once and cached, and
+// the result of a navmesh raycast from that point to the player's nav location: the same test
+// perception runs per agent. Raycasts are redone, nearest cells first, whenever the player
+// changes cell. A wall can still cross a cell, so only agents standing close to their cell's
+// sample point take the answer; the rest trace for themselves.
+UCLASS()
+class USwarmVisibilityFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Game thread only. Recentres on the player's nav location and resolves pending cells.
+	void Tick(const FVector& PlayerNavLoc, int32& OutQueries);
+
+	void Reset();
+
+	// False outside the field, on cells not resolved yet, or when Pos is off the cell's floor
+	// or more than MaxSampleOffset from its sample point. Read-only, safe from parallel chunks.
+	bool SampleVisibility(const FVector& Pos, bool& bOutVisible) const;
+
+	FORCEINLINE bool HasField() const { return bValid; }
+
+public:
+	UPROPERTY() float CellSize           = 200.f;
+	UPROPERTY() int32 HalfExtentCells    = 10;
+	UPROPERTY() float MaxStepHeight      = 120.f;
+	UPROPERTY() float MaxSampleOffset    = 60.f;
+	// Navmesh projections plus raycasts.
+	UPROPERTY() int32 QueriesPerTick     = 256;
+
+private:
+	enum class EVis : uint8
+	{
+		Unknown,
+		Hidden,
+		Visible
+	};
+
+	struct FWalkSample
+	{
+		FVector Location = FVector::ZeroVector;
+		bool    bWalkable = false;
+	};
+
+	FORCEINLINE FIntPoint WorldToCell(const FVector& P) const
+	{
+		return FIntPoint(FMath::FloorToInt(P.X / CellSize), FMath::FloorToInt(P.Y / CellSize));
+	}
+
+	FORCEINLINE int32 IndexOf(const FIntPoint& Cell) const
+	{
+		const FIntPoint L = Cell - Origin;
+		return (L.X < 0 || L.Y < 0 || L.X >= Size || L.Y >= Size) ? INDEX_NONE : L.Y * Size + L.X;
+	}
+
+	void Recentre(const FIntPoint& Cell, const FVector& PlayerNavLoc);
+	const FWalkSample& SampleCell(UNavigationSystemV1* NavSys, const ANavigationData* NavData, const FIntPoint& Cell);
+	int32 ResolveCell(UNavigationSystemV1* NavSys, const ANavigationData* NavData, const FIntPoint& Cell);
+
+	FIntPoint PlayerCell   = FIntPoint::ZeroValue;
+	FIntPoint Origin       = FIntPoint::ZeroValue;
+	FVector   PlayerTarget = FVector::ZeroVector;
+	int32     Size         = 0;
+
+	TArray<EVis>      Vis;
+	TArray<FVector3f> Points;
+
+	bool bValid = false;
+
+	// Field cells not raycast yet, farthest first so Pop takes the nearest.
+	TArray<FIntPoint> Pending;
+
+	// Navmesh is static for the lifetime of a wave; samples are kept across recentres.
+	TMap<FIntPoint, FWalkSample> WalkCache;
+};
@@ -0,0 +1,139 @@
+#include "SwarmDormancySubsystem.h"
+
+#include "MassEntityManager.h"
+
+void USwarmDormancySubsystem::Deinitialize()
+{
+	Reset();
+	Super::Deinitialize();
+}
+
+void USwarmDormancySubsystem::Reset()
+{
+	Parked.Empty();
+	Cells.Empty();
+	Expiry.Empty();
+	WakeQueue.Empty();
+	ExpiryHead     = 0;
+	LastPlayerCell = FIntPoint(MAX_int32, MAX_int32);
+	LastScan       = -DBL_MAX;
+}
+
+void USwarmDormancySubsystem::Park(const FMassEntityHandle Entity, const FVector& Location, double Now)
+{
+	if (Parked.Contains(Entity))
+		return;
+
+	const FIntPoint Cell = WorldToCell(Location);
+	Parked.Add(Entity, { Cell, Now });
+	Cells.FindOrAdd(Cell).Add(Entity);
+	Expiry.Add({ Entity, Now });
+}
+
+void USwarmDormancySubsystem::Unpark(const FMassEntityHandle Entity, const FIntPoint& Cell)
+{
+	Parked.Remove(Entity);
+	if (TArray<FMassEntityHandle>* Members = Cells.Find(Cell))
+	{
+		Members->RemoveSingleSwap(Entity, EAllowShrinking::No);
+		if (Members->Num() == 0)
+			Cells.Remove(Cell);
+	}
+	WakeQueue.Add(Entity);
+}
+
+void USwarmDormancySubsystem::ScanNearPlayer(const FVector& PlayerLocation)
+{
+	const FIntPoint Center = WorldToCell(PlayerLocation);
+	const int32     Radius = FMath::CeilToInt(WakeDistance / WakeCellSize);
+	const float     WakeSq = FMath::Square(WakeDistance);
+
+	for (int32 y = -Radius; y <= Radius; ++y)
+	{
+		for (int32 x = -Radius; x <= Radius; ++x)
+		{
+			const FIntPoint Cell = Center + FIntPoint(x, y);
+			TArray<FMassEntityHandle>* Members = Cells.Find(Cell);
+			if (!Members)
+				continue;
+
+			// Nearest point of the cell to the player.
+			const FVector2D Min(Cell.X * WakeCellSize, Cell.Y * WakeCellSize);
+			const FVector2D Near(FMath::Clamp<double>(PlayerLocation.X, Min.X, Min.X + WakeCellSize),
+			                     FMath::Clamp<double>(PlayerLocation.Y, Min.Y, Min.Y + WakeCellSize));
+			if (FVector2D::DistSquared(Near, FVector2D(PlayerLocation)) > WakeSq)
+				continue;
+
+			for (const FMassEntityHandle& E : *Members)
+			{
+				Parked.Remove(E);
+				WakeQueue.Add(E);
+			}
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+// Every parked agent sits in exactly one wake cell, so walking the cells covers the index.
+// Expiry entries of dropped agents no longer match Parked and are skipped at the head.
+void USwarmDormancySubsystem::RemoveDestroyed(const FMassEntityManager& EntityManager)
+{
+	for (auto It = Cells.CreateIterator(); It; ++It)
+	{
+		TArray<FMassEntityHandle>& Members = It.Value();
+		for (int32 m = Members.Num() - 1; m >= 0; --m)
+		{
+			if (EntityManager.IsEntityValid(Members[m]))
+				continue;
+
+			Parked.Remove(Members[m]);
+			Members.RemoveAtSwap(m, 1, EAllowShrinking::No);
+		}
+		if (Members.Num() == 0)
+			It.RemoveCurrent();
+	}
+
+	WakeQueue.RemoveAll([&EntityManager](const FMassEntityHandle& E) { return !EntityManager.IsEntityValid(E); });
+}
+
+void USwarmDormancySubsystem::CollectWakes(const FMassEntityManager& EntityManager, const FVector& PlayerLocation, double Now, TArray<FMassEntityHandle>& OutWake)
+{
+	const FIntPoint PlayerCell = WorldToCell(PlayerLocation);
+	if (PlayerCell != LastPlayerCell || Now - LastScan >= RescanInterval)
+	{
+		RemoveDestroyed(EntityManager);
+		ScanNearPlayer(PlayerLocation);
+		LastPlayerCell = PlayerCell;
+		LastScan       = Now;
+	}
+
+	const int32 Batch = FMath::Max(1, WakeBatch);
+	if (MaxSleepSeconds > 0.f)
+	{
+		while (ExpiryHead < Expiry.Num() && WakeQueue.Num() < Batch)
+		{
+			const FExpiry& E = Expiry[ExpiryHead];
+			if (Now - E.ParkedAt < MaxSleepSeconds)
+				break;
+
+			const FParkInfo* Info = Parked.Find(E.Entity);
+			if (Info && Info->ParkedAt == E.ParkedAt)
+				Unpark(E.Entity, Info->Cell);
+			++ExpiryHead;
+		}
+	}
+
+	// Compact once the consumed head dominates.
+	if (ExpiryHead > 1024 && ExpiryHead * 2 > Expiry.Num())
+	{
+		Expiry.RemoveAt(0, ExpiryHead, EAllowShrinking::No);
+		ExpiryHead = 0;
+	}
+
+	const int32 Take = FMath::Min(Batch, WakeQueue.Num());
+	if (Take == 0)
+		return;
+
+	OutWake.Append(WakeQueue.GetData(), Take);
+	WakeQueue.RemoveAt(0, Take, EAllowShrinking::No);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SwarmDormancySubsystem.generated.h"
+
+struct FMassEntityManager;
+
+// Index of parked agents. Beyond SleepDistance every agent parks; between WakeDistance and
+// SleepDistance only agents with no path do. Parked agents carry FSwarmDormantTag, so no
+// per-frame stage touches them and they are left out of the agent grid. They are tracked only
+// here, in a coarse wake grid, and keep their path so a wake resumes it. Wakes come in two
+// kinds. Proximity wakes take every agent in the wake cells within WakeDistance of the player,
+// rescanned when the player changes wake cell or every RescanInterval. Timer wakes take agents
+// parked longer than MaxSleepSeconds, oldest first, so the far crowd still drifts in. Woken
+// agents are handed out at most WakeBatch per frame. Agents destroyed while parked are dropped
+// at the next rescan. Game thread only.
+UCLASS()
+class USwarmDormancySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	void Park(const FMassEntityHandle Entity, const FVector& Location, double Now);
+
+	// Appends up to WakeBatch agents due to wake and drops them from the index.
+	void CollectWakes(const FMassEntityManager& EntityManager, const FVector& PlayerLocation, double Now, TArray<FMassEntityHandle>& OutWake);
+
+	FORCEINLINE int32 GetNumParked() const { return Parked.Num() + WakeQueue.Num(); }
+
+	void Reset();
+
+public:
+	UPROPERTY() float SleepDistance       = 8000.f;
+	UPROPERTY() float WakeDistance        = 7000.f;
+	UPROPERTY() float WakeCellSize        = 2000.f;
+	UPROPERTY() float MaxSleepSeconds     = 10.f;
+	UPROPERTY() float MinAwakeSeconds     = 3.f;
+	UPROPERTY() float RescanInterval      = 0.5f;
+	UPROPERTY() int32 WakeBatch           = 256;
+	UPROPERTY() int32 SleepCheckDivisor   = 15;
+
+private:
+	struct FParkInfo
+	{
+		FIntPoint Cell;
+		double    ParkedAt = 0.0;
+	};
+
+	struct FExpiry
+	{
+		FMassEntityHandle Entity;
+		double            ParkedAt = 0.0;
+	};
+
+	FORCEINLINE FIntPoint WorldToCell(const FVector& P) const
+	{
+		return FIntPoint(FMath::FloorToInt(P.X / WakeCellSize), FMath::FloorToInt(P.Y / WakeCellSize));
+	}
+
+	void Unpark(const FMassEntityHandle Entity, const FIntPoint& Cell);
+	void ScanNearPlayer(const FVector& PlayerLocation);
+	void RemoveDestroyed(const FMassEntityManager& EntityManager);
+
+	TMap<FMassEntityHandle, FParkInfo>          Parked;
+	TMap<FIntPoint, TArray<FMassEntityHandle>>  Cells;
+
+	// Parked order is time order, so the oldest is always at ExpiryHead. Entries for agents
+	// already woken some other way are skipped when they reach the head.
+	TArray<FExpiry> Expiry;
+	int32           ExpiryHead = 0;
+
+	TArray<FMassEntityHandle> WakeQueue;
+
+	FIntPoint LastPlayerCell = FIntPoint(MAX_int32, MAX_int32);
+	double    LastScan       = -DBL_MAX;
+};
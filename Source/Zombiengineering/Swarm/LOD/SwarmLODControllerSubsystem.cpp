@@ -0,0 +1,109 @@
+#include "SwarmLODControllerSubsystem.h"
+
+#include "Algo/Sort.h"
+
+void USwarmLODControllerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	ResetShifts();
+}
+
+void USwarmLODControllerSubsystem::ResetShifts()
+{
+	FMemory::Memcpy(Shifts, BaseShifts, sizeof(Shifts));
+	bPrimed = false;
+}
+
+ESwarmLODTier USwarmLODControllerSubsystem::TierFor(float DistSq2D, ESwarmLODTier Current) const
+{
+	const ESwarmLODTier Raw = TierFor(DistSq2D);
+	if (Raw == Current)
+		return Raw;
+
+	const float D = FMath::Sqrt(DistSq2D);
+	if (Raw > Current)
+		return FMath::Max(Current, TierFor(FMath::Square(FMath::Max(0.f, D - TierHysteresis))));
+	return FMath::Min(Current, TierFor(FMath::Square(D + TierHysteresis)));
+}
+
+int32 USwarmLODControllerSubsystem::GetPressure() const
+{
+	int32 Pressure = 0;
+	for (int32 s = 0; s < NumStages; ++s)
+	{
+		for (int32 t = 0; t < NumTiers; ++t)
+			Pressure += int32(Shifts[s][t]) - int32(BaseShifts[s][t]);
+	}
+	return Pressure;
+}
+
+void USwarmLODControllerSubsystem::Feed(const FSwarmStageCosts& Costs, double Now)
+{
+	const double Alpha = FMath::Clamp(SmoothingAlpha, 0.01f, 1.f);
+	if (!bPrimed)
+	{
+		SmoothedMs = Costs.TotalMs;
+		for (int32 s = 0; s < NumStages; ++s)
+			StageMs[s] = Costs.Ms[s];
+		LastAdjust = Now;
+		bPrimed    = true;
+		return;
+	}
+
+	SmoothedMs = FMath::Lerp(SmoothedMs, Costs.TotalMs, Alpha);
+	for (int32 s = 0; s < NumStages; ++s)
+		StageMs[s] = FMath::Lerp(StageMs[s], Costs.Ms[s], Alpha);
+
+	if (Now - LastAdjust < AdjustInterval || TargetMs <= 0.f)
+		return;
+	LastAdjust = Now;
+
+	const double Ratio = SmoothedMs / TargetMs;
+	if (Ratio <= 1.0 + Deadband && Ratio >= 1.0 - Deadband)
+		return;
+
+	const bool bOver = Ratio > 1.0;
+
+	// Costliest stage first when shedding load, cheapest first when buying fidelity back.
+	int32 Order[NumStages];
+	for (int32 s = 0; s < NumStages; ++s)
+		Order[s] = s;
+	Algo::Sort(Order, [&](int32 A, int32 B) { return bOver ? StageMs[A] > StageMs[B] : StageMs[A] < StageMs[B]; });
+
+	for (const int32 s : Order)
+	{
+		if (bOver ? Degrade(s) : Restore(s))
+			break;
+	}
+}
+
+bool USwarmLODControllerSubsystem::Degrade(int32 Stage)
+{
+	uint8* S = Shifts[Stage];
+	for (int32 t = NumTiers - 1; t >= 0; --t)
+	{
+		const int32 Cap = (t == int32(ESwarmLODTier::Near)) ? FMath::Min(MaxNearShift, MaxShift) : MaxShift;
+		const bool  bKeepsOrder = (t == NumTiers - 1) || (S[t] < S[t + 1]);
+		if (S[t] < Cap && bKeepsOrder)
+		{
+			++S[t];
+			return true;
+		}
+	}
+	return false;
+}
+
+bool USwarmLODControllerSubsystem::Restore(int32 Stage)
+{
+	uint8* S = Shifts[Stage];
+	for (int32 t = 0; t < NumTiers; ++t)
+	{
+		const bool bKeepsOrder = (t == 0) || (S[t] > S[t - 1]);
+		if (S[t] > 0 && bKeepsOrder)
+		{
+			--S[t];
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SwarmLODControllerSubsystem.generated.h"
+
+enum class ESwarmLODTier : uint8
+{
+	Near,
+	Mid,
+	Far,
+
+	Num
+};
+
+enum class ESwarmLODStage : uint8
+{
+	Sense,
+	Follow,
+	Separation,
+
+	Num
+};
+
+struct FSwarmStageCosts
+{
+	double Ms[uint8(ESwarmLODStage::Num)] = {};
+	double TotalMs = 0.0;
+};
+
+// Feedback controller that keeps the swarm's per-frame cost near TargetMs by changing how
+// often each stage updates agents in each distance tier. Every (stage, tier) has a shift:
+// the stage runs for an agent every 2^shift frames. Over budget, the costliest stage that
+// can still give something up is slowed in its farthest tier first. Under budget, the
+// cheapest stage that has been slowed is restored in its nearest tier first. Shifts never
+// decrease with distance and Near never goes past MaxNearShift. One step per AdjustInterval,
+// with a deadband, so the masks don't chase frame noise.
+UCLASS()
+class USwarmLODControllerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Game thread, once per frame after all stages have reported.
+	void Feed(const FSwarmStageCosts& Costs, double Now);
+
+	FORCEINLINE ESwarmLODTier TierFor(float DistSq2D) const
+	{
+		return DistSq2D >= FMath::Square(FarDistance)  ? ESwarmLODTier::Far
+			 : DistSq2D >= FMath::Square(NearDistance) ? ESwarmLODTier::Mid
+			 : ESwarmLODTier::Near;
+	}
+
+	// Sticky variant for agents already in a tier: leaving it takes TierHysteresis past the
+	// boundary, so agents on a boundary don't bounce between archetypes.
+	ESwarmLODTier TierFor(float DistSq2D, ESwarmLODTier Current) const;
+
+	FORCEINLINE uint8 GetMask(ESwarmLODStage Stage, ESwarmLODTier Tier) const
+	{
+		return uint8((1u << Shifts[uint8(Stage)][uint8(Tier)]) - 1u);
+	}
+
+	FORCEINLINE double GetSmoothedCostMs() const { return SmoothedMs; }
+
+	// Total shift applied above the starting policy; negative when running richer than it.
+	int32 GetPressure() const;
+
+	void ResetShifts();
+
+public:
+	UPROPERTY() float  TargetMs       = 4.0f;
+	UPROPERTY() float  Deadband       = 0.15f;
+	UPROPERTY() float  SmoothingAlpha = 0.1f;
+	UPROPERTY() double AdjustInterval = 0.25;
+
+	UPROPERTY() float NearDistance = 1500.f;
+	UPROPERTY() float FarDistance  = 4000.f;
+	UPROPERTY() float TierHysteresis = 150.f;
+
+	UPROPERTY() int32 MaxShift     = 4;
+	UPROPERTY() int32 MaxNearShift = 1;
+
+private:
+	bool Degrade(int32 Stage);
+	bool Restore(int32 Stage);
+
+	static constexpr int32 NumStages = int32(ESwarmLODStage::Num);
+	static constexpr int32 NumTiers  = int32(ESwarmLODTier::Num);
+
+	// The policy this replaces: Sense 1/2/8, Follow 1/2/4 frames, Separation by distance 1/2/4.
+	static constexpr uint8 BaseShifts[NumStages][NumTiers] = { { 0, 1, 3 }, { 0, 1, 2 }, { 0, 1, 2 } };
+
+	uint8  Shifts[NumStages][NumTiers] = {};
+	double StageMs[NumStages] = {};
+	double SmoothedMs = 0.0;
+	double LastAdjust = 0.0;
+	bool   bPrimed    = false;
+};
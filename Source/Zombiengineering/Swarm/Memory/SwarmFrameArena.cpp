@@ -0,0 +1,123 @@
+#include "SwarmFrameArena.h"
+
+#include "HAL/UnrealMemory.h"
+
+static thread_local FSwarmLinearArena* GSwarmCurrentArena = nullptr;
+
+FSwarmLinearArena::FSwarmLinearArena(SIZE_T InBlockSize)
+	: BlockSize(FMath::Max<SIZE_T>(InBlockSize, 4 * 1024))
+{
+}
+
+FSwarmLinearArena::~FSwarmLinearArena()
+{
+	FreeBlocks();
+}
+
+FSwarmLinearArena* FSwarmLinearArena::GetCurrent()
+{
+	return GSwarmCurrentArena;
+}
+
+void FSwarmLinearArena::AddBlock(SIZE_T MinBytes)
+{
+	FBlock& B = Blocks.AddDefaulted_GetRef();
+	B.Size = FMath::Max(BlockSize, Align(MinBytes, 4096));
+	B.Data = (uint8*)FMemory::Malloc(B.Size, 64);
+	ReservedBytes += B.Size;
+	++NumBlockAllocs;
+}
+
+void FSwarmLinearArena::FreeBlocks()
+{
+	for (FBlock& B : Blocks)
+	{
+		FMemory::Free(B.Data);
+	}
+	Blocks.Reset();
+	ReservedBytes = 0;
+	CurrentBlock  = INDEX_NONE;
+	Offset        = 0;
+	LastAlloc     = nullptr;
+}
+
+void* FSwarmLinearArena::Allocate(SIZE_T Bytes, SIZE_T Alignment)
+{
+	Bytes = FMath::Max<SIZE_T>(Bytes, 1);
+
+	while (true)
+	{
+		if (CurrentBlock != INDEX_NONE)
+		{
+			FBlock& B = Blocks[CurrentBlock];
+			const UPTRINT Base    = (UPTRINT)B.Data;
+			const UPTRINT Aligned = Align(Base + Offset, Alignment);
+			const SIZE_T  End     = SIZE_T(Aligned - Base) + Bytes;
+			if (End <= B.Size)
+			{
+				BytesUsed += End - Offset;
+				Offset     = End;
+				LastAlloc  = (void*)Aligned;
+				return LastAlloc;
+			}
+		}
+
+		if (CurrentBlock + 1 >= Blocks.Num())
+		{
+			AddBlock(Bytes + Alignment);
+		}
+		++CurrentBlock;
+		Offset = 0;
+	}
+}
+
+void* FSwarmLinearArena::Reallocate(void* Ptr, SIZE_T OldBytes, SIZE_T NewBytes, SIZE_T CopyBytes, SIZE_T Alignment)
+{
+	if (Ptr && Ptr == LastAlloc && CurrentBlock != INDEX_NONE)
+	{
+		FBlock& B = Blocks[CurrentBlock];
+		const SIZE_T Start = SIZE_T((uint8*)Ptr - B.Data);
+		if (Start + NewBytes <= B.Size)
+		{
+			const SIZE_T End = Start + NewBytes;
+			BytesUsed = BytesUsed - (Offset - Start) + NewBytes;
+			Offset    = End;
+			return Ptr;
+		}
+	}
+
+	void* NewPtr = Allocate(NewBytes, Alignment);
+	if (Ptr && CopyBytes)
+	{
+		FMemory::Memcpy(NewPtr, Ptr, FMath::Min(CopyBytes, FMath::Min(OldBytes, NewBytes)));
+	}
+	return NewPtr;
+}
+
+void FSwarmLinearArena::Reset()
+{
+	HighWaterBytes = FMath::Max(HighWaterBytes, BytesUsed);
+
+	if (Blocks.Num() > 1)
+	{
+		const SIZE_T Wanted = FMath::Max(ReservedBytes, HighWaterBytes);
+		FreeBlocks();
+		AddBlock(Wanted);
+	}
+
+	CurrentBlock = Blocks.Num() > 0 ? 0 : INDEX_NONE;
+	Offset       = 0;
+	LastAlloc    = nullptr;
+	BytesUsed    = 0;
+}
+
+FSwarmArenaScope::FSwarmArenaScope(FSwarmLinearArena* InArena)
+	: Previous(GSwarmCurrentArena)
+{
+	GSwarmCurrentArena = InArena;
+}
+
+FSwarmArenaScope::~FSwarmArenaScope()
+{
+	GSwarmCurrentArena = Previous;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+
+// Bump allocator for data that lives at most one swarm frame. Not thread-safe:
+// every worker gets its own instance (see USwarmFrameArenaSubsystem).
+class FSwarmLinearArena
+{
+public:
+	explicit FSwarmLinearArena(SIZE_T InBlockSize = 256 * 1024);
+	~FSwarmLinearArena();
+
+	FSwarmLinearArena(const FSwarmLinearArena&) = delete;
+	FSwarmLinearArena& operator=(const FSwarmLinearArena&) = delete;
+
+	void* Allocate(SIZE_T Bytes, SIZE_T Alignment = alignof(uint64));
+	void* Reallocate(void* Ptr, SIZE_T OldBytes, SIZE_T NewBytes, SIZE_T CopyBytes, SIZE_T Alignment);
+
+	// Releases everything at once. Blocks are kept (and coalesced) for the next frame.
+	void Reset();
+
+	FORCEINLINE SIZE_T GetBytesUsed()      const { return BytesUsed; }
+	FORCEINLINE SIZE_T GetHighWaterBytes() const { return HighWaterBytes; }
+	FORCEINLINE SIZE_T GetReservedBytes()  const { return ReservedBytes; }
+	FORCEINLINE uint32 GetNumBlockAllocs() const { return NumBlockAllocs; }
+
+	// Arena bound to the calling thread by FSwarmArenaScope, or nullptr.
+	static FSwarmLinearArena* GetCurrent();
+
+private:
+	struct FBlock
+	{
+		uint8* Data = nullptr;
+		SIZE_T Size = 0;
+	};
+
+	void AddBlock(SIZE_T MinBytes);
+	void FreeBlocks();
+
+	const SIZE_T BlockSize;
+
+	TArray<FBlock, TInlineAllocator<4>> Blocks;
+	int32  CurrentBlock = INDEX_NONE;
+	SIZE_T Offset       = 0;
+	void*  LastAlloc    = nullptr;
+
+	SIZE_T BytesUsed      = 0;
+	SIZE_T HighWaterBytes = 0;
+	SIZE_T ReservedBytes  = 0;
+	uint32 NumBlockAllocs = 0;
+};
+
+// Binds an arena to the calling thread for the lifetime of the scope.
+struct FSwarmArenaScope
+{
+	explicit FSwarmArenaScope(FSwarmLinearArena* InArena);
+	explicit FSwarmArenaScope(FSwarmLinearArena& InArena) : FSwarmArenaScope(&InArena) {}
+	~FSwarmArenaScope();
+
+	FSwarmArenaScope(const FSwarmArenaScope&) = delete;
+	FSwarmArenaScope& operator=(const FSwarmArenaScope&) = delete;
+
+private:
+	FSwarmLinearArena* Previous;
+};
+
+// TArray allocator drawing from the thread's current arena, falling back to the heap
+// when no arena is bound. Frees are no-ops for arena memory. Containers using it must
+// not outlive the arena's frame nor be resized from another thread.
+class FSwarmArenaAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = false };
+	enum { RequireRangeCheck = true };
+
+	class ForAnyElementType
+	{
+	public:
+		ForAnyElementType() = default;
+		ForAnyElementType(const ForAnyElementType&) = delete;
+		ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+		FORCEINLINE ~ForAnyElementType()
+		{
+			Release();
+		}
+
+		FORCEINLINE void MoveToEmpty(ForAnyElementType& Other)
+		{
+			checkSlow(this != &Other);
+			Release();
+			Data  = Other.Data;
+			Arena = Other.Arena;
+			Other.Data  = nullptr;
+			Other.Arena = nullptr;
+		}
+
+		FORCEINLINE FScriptContainerElement* GetAllocation() const { return Data; }
+
+		FORCEINLINE void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+		{
+			ResizeAllocation(CurrentNum, NewMax, NumBytesPerElement, alignof(uint64));
+		}
+
+		void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement)
+		{
+			if (NewMax <= 0)
+			{
+				Release();
+				return;
+			}
+
+			const SIZE_T NewBytes  = SIZE_T(NewMax) * NumBytesPerElement;
+			const SIZE_T ElemAlign = FMath::Max<SIZE_T>(AlignmentOfElement, alignof(uint64));
+
+			if (!Data)
+			{
+				Arena = FSwarmLinearArena::GetCurrent();
+				Data  = (FScriptContainerElement*)(Arena ? Arena->Allocate(NewBytes, ElemAlign) : FMemory::Malloc(NewBytes, ElemAlign));
+			}
+			else if (Arena)
+			{
+				const SIZE_T CopyBytes = SIZE_T(CurrentNum) * NumBytesPerElement;
+				Data = (FScriptContainerElement*)Arena->Reallocate(Data, CopyBytes, NewBytes, CopyBytes, ElemAlign);
+			}
+			else
+			{
+				Data = (FScriptContainerElement*)FMemory::Realloc(Data, NewBytes, ElemAlign);
+			}
+		}
+
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false);
+		}
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+		{
+			return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false, AlignmentOfElement);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+		{
+			return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false, AlignmentOfElement);
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false);
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+		{
+			return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false, AlignmentOfElement);
+		}
+
+		FORCEINLINE SIZE_T GetAllocatedSize(SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return SIZE_T(CurrentMax) * NumBytesPerElement;
+		}
+
+		FORCEINLINE bool     HasAllocation()       const { return !!Data; }
+		FORCEINLINE SizeType GetInitialCapacity()  const { return 0; }
+
+	private:
+		FORCEINLINE void Release()
+		{
+			if (Data && !Arena)
+			{
+				FMemory::Free(Data);
+			}
+			Data  = nullptr;
+			Arena = nullptr;
+		}
+
+		FScriptContainerElement* Data  = nullptr;
+		FSwarmLinearArena*       Arena = nullptr;
+	};
+
+	template <typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return (ElementType*)ForAnyElementType::GetAllocation();
+		}
+	};
+};
+
+template <>
+struct TAllocatorTraits<FSwarmArenaAllocator> : TAllocatorTraitsBase<FSwarmArenaAllocator>
+{
+	enum { SupportsMove    = true };
+	enum { IsZeroConstruct = true };
+};
+
+// Allocator policy for TestHashTable::THashTable. Binds to the current arena on construction.
+struct FSwarmArenaHashAllocator
+{
+	FSwarmArenaHashAllocator() : Arena(FSwarmLinearArena::GetCurrent()) {}
+
+	void* Allocate(size_t Bytes)
+	{
+		return Arena ? Arena->Allocate(Bytes, alignof(uint64)) : FMemory::Malloc(Bytes, alignof(uint64));
+	}
+
+	void Deallocate(void* Ptr)
+	{
+		if (!Arena) FMemory::Free(Ptr);
+	}
+
+	FSwarmLinearArena* Arena;
+};
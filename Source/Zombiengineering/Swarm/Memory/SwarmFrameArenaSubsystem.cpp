@@ -0,0 +1,85 @@
+#include "SwarmFrameArenaSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+
+#include <atomic>
+
+static std::atomic<uint32> GSwarmArenaSubsystemSerial{ 0 };
+
+void USwarmFrameArenaSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Serial = ++GSwarmArenaSubsystemSerial;
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USwarmFrameArenaSubsystem::OnWorldPostActorTick);
+}
+
+void USwarmFrameArenaSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	{
+		FScopeLock L(&ArenasCS);
+		WorkerArenas.Reset();
+	}
+	Serial = 0;
+	Super::Deinitialize();
+}
+
+FSwarmLinearArena& USwarmFrameArenaSubsystem::GetWorkerArena()
+{
+	struct FThreadCache
+	{
+		uint32 Serial = 0;
+		FSwarmLinearArena* Arena = nullptr;
+	};
+	thread_local FThreadCache Cache;
+
+	if (Cache.Serial == Serial && Cache.Arena)
+	{
+		return *Cache.Arena;
+	}
+
+	const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	FScopeLock L(&ArenasCS);
+	TUniquePtr<FSwarmLinearArena>& Arena = WorkerArenas.FindOrAdd(ThreadId);
+	if (!Arena)
+	{
+		Arena = MakeUnique<FSwarmLinearArena>(SIZE_T(FMath::Max(4, BlockSizeKB)) * 1024);
+	}
+	Cache.Serial = Serial;
+	Cache.Arena  = Arena.Get();
+	return *Arena;
+}
+
+SIZE_T USwarmFrameArenaSubsystem::GetFrameBytesUsed() const
+{
+	FScopeLock L(&ArenasCS);
+	SIZE_T Bytes = 0;
+	for (const auto& Pair : WorkerArenas)
+	{
+		Bytes += Pair.Value->GetBytesUsed();
+	}
+	return Bytes;
+}
+
+void USwarmFrameArenaSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick, float)
+{
+	if (InWorld == GetWorld())
+	{
+		ResetFrame();
+	}
+}
+
+void USwarmFrameArenaSubsystem::ResetFrame()
+{
+	FScopeLock L(&ArenasCS);
+	SIZE_T Bytes = 0;
+	for (auto& Pair : WorkerArenas)
+	{
+		Bytes += Pair.Value->GetBytesUsed();
+		Pair.Value->Reset();
+	}
+	HighWaterBytes = FMath::Max(HighWaterBytes, Bytes);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "HAL/CriticalSection.h"
+#include "Swarm/Memory/SwarmFrameArena.h"
+#include "SwarmFrameArenaSubsystem.generated.h"
+
+UCLASS()
+class USwarmFrameArenaSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	FSwarmLinearArena& GetWorkerArena();
+
+	SIZE_T GetFrameBytesUsed() const;
+	FORCEINLINE SIZE_T GetHighWaterBytes() const { return HighWaterBytes; }
+	FORCEINLINE int32  GetNumWorkerArenas() const { return WorkerArenas.Num(); }
+
+public:
+	UPROPERTY() int32 BlockSizeKB = 256;
+
+private:
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void ResetFrame();
+
+	mutable FCriticalSection ArenasCS;
+	TMap<uint32, TUniquePtr<FSwarmLinearArena>> WorkerArenas;
+
+	uint32 Serial = 0;
+	SIZE_T HighWaterBytes = 0;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,41 @@
+#include "SwarmMappedFile.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+bool FSwarmMappedFile::Open(const FString& Path)
+{
+	Close();
+
+	IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(PF.OpenMapped(*Path));
+	if (MappedFile)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (MappedRegion)
+		{
+			Data = MappedRegion->GetMappedPtr();
+			Size = MappedRegion->GetMappedSize();
+			return true;
+		}
+		MappedFile.Reset();
+	}
+
+	// Platforms without mapping support read the file once instead.
+	if (FFileHelper::LoadFileToArray(OwnedBytes, *Path, FILEREAD_Silent))
+	{
+		Data = OwnedBytes.GetData();
+		Size = OwnedBytes.Num();
+		return true;
+	}
+	return false;
+}
+
+void FSwarmMappedFile::Close()
+{
+	Data = nullptr;
+	Size = 0;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	OwnedBytes.Empty();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+
+// Read-only view of a whole file: memory-mapped where the platform supports it, read into
+// memory otherwise. The bytes stay valid until Close or destruction.
+class FSwarmMappedFile
+{
+public:
+	~FSwarmMappedFile() { Close(); }
+
+	bool Open(const FString& Path);
+	void Close();
+
+	FORCEINLINE bool         IsOpen()  const { return Data != nullptr; }
+	FORCEINLINE const uint8* GetData() const { return Data; }
+	FORCEINLINE int64        GetSize() const { return Size; }
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> OwnedBytes;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
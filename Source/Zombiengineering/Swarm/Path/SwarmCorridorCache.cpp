@@ -0,0 +1,147 @@
+#include "SwarmCorridorCache.h"
+
+#include "NavMesh/NavMeshPath.h"
+
+namespace
+{
+	FORCEINLINE float Cross2D(const FVector& A, const FVector& B)
+	{
+		return float(A.X * B.Y - A.Y * B.X);
+	}
+}
+
+void FSwarmCorridorCache::Add(const FSwarmPathKey& Key, TConstArrayView<NavNodeRef> Polys,
+	TConstArrayView<FNavigationPortalEdge> Portals, const FVector& Start, const FVector& End, double Now)
+{
+	if (Polys.Num() < 2 || Portals.Num() != Polys.Num() - 1)
+		return;
+
+	FCorridor* C = Corridors.Find(Key);
+	if (!C)
+	{
+		if (Corridors.Num() >= MaxCorridors && Order.Num() > 0)
+		{
+			Corridors.Remove(Order[OrderHead]);
+			Order[OrderHead] = Key;
+			OrderHead = (OrderHead + 1) % Order.Num();
+		}
+		else
+		{
+			Order.Add(Key);
+		}
+		C = &Corridors.Add(Key);
+	}
+
+	C->Polys  = Polys;
+	C->End    = End;
+	C->Time   = Now;
+	C->Lefts.Reset(Portals.Num());
+	C->Rights.Reset(Portals.Num());
+
+	// Orient every portal against the direction of travel through it.
+	const int32 N = Portals.Num();
+	for (int32 i = 0; i < N; ++i)
+	{
+		const FVector Prev = (i == 0)     ? Start : Portals[i - 1].GetMiddlePoint();
+		const FVector Next = (i == N - 1) ? End   : Portals[i + 1].GetMiddlePoint();
+
+		FVector L = Portals[i].Left, R = Portals[i].Right;
+		if (Cross2D(Next - Prev, R - L) < 0.f)
+			Swap(L, R);
+
+		C->Lefts.Add(L);
+		C->Rights.Add(R);
+	}
+}
+
+const FSwarmCorridorCache::FCorridor* FSwarmCorridorCache::FindContaining(const FSwarmPathKey& Key, NavNodeRef StartPoly,
+	double Now, int32& OutIndex) const
+{
+	for (int32 dz = -1; dz <= 1; ++dz)
+	for (int32 dy = -1; dy <= 1; ++dy)
+	for (int32 dx = -1; dx <= 1; ++dx)
+	{
+		const FSwarmPathKey Probe{ Key.Start + FIntVector(dx, dy, dz), Key.Goal };
+		const FCorridor* C = Corridors.Find(Probe);
+		if (!C || Now - C->Time > MaxAge)
+			continue;
+
+		const int32 Idx = C->Polys.IndexOfByKey(StartPoly);
+		if (Idx != INDEX_NONE)
+		{
+			OutIndex = Idx;
+			return C;
+		}
+	}
+	return nullptr;
+}
+
+void FSwarmCorridorCache::Empty()
+{
+	Corridors.Reset();
+	Order.Reset();
+	OrderHead = 0;
+}
+
+void SwarmPath::StringPull(const FVector& Start, const FVector& End, TConstArrayView<FVector> Lefts,
+	TConstArrayView<FVector> Rights, TArray<FVector>& OutPoints)
+{
+	// Portal 0 is the start point, the last one the end point.
+	const int32 N = Lefts.Num() + 2;
+	auto PortalL = [&](int32 i) -> const FVector& { return i == 0 ? Start : (i == N - 1 ? End : Lefts[i - 1]); };
+	auto PortalR = [&](int32 i) -> const FVector& { return i == 0 ? Start : (i == N - 1 ? End : Rights[i - 1]); };
+
+	OutPoints.Add(Start);
+
+	FVector Apex = Start, FunnelL = Start, FunnelR = Start;
+	int32   ApexIdx = 0, LeftIdx = 0, RightIdx = 0;
+
+	for (int32 i = 1; i < N; ++i)
+	{
+		const FVector& PL = PortalL(i);
+		const FVector& PR = PortalR(i);
+
+		// Right edge: tighten when the new point is not outside the funnel.
+		if (Cross2D(FunnelR - Apex, PR - Apex) <= 0.f)
+		{
+			if (Apex.Equals(FunnelR, 1e-3f) || Cross2D(FunnelL - Apex, PR - Apex) > 0.f)
+			{
+				FunnelR  = PR;
+				RightIdx = i;
+			}
+			else
+			{
+				// Crossed the left edge: its end becomes a corner and the new apex.
+				Apex = FunnelL;
+				ApexIdx = LeftIdx;
+				OutPoints.Add(Apex);
+				FunnelL = FunnelR = Apex;
+				LeftIdx = RightIdx = ApexIdx;
+				i = ApexIdx;
+				continue;
+			}
+		}
+
+		if (Cross2D(FunnelL - Apex, PL - Apex) >= 0.f)
+		{
+			if (Apex.Equals(FunnelL, 1e-3f) || Cross2D(FunnelR - Apex, PL - Apex) < 0.f)
+			{
+				FunnelL = PL;
+				LeftIdx = i;
+			}
+			else
+			{
+				Apex = FunnelR;
+				ApexIdx = RightIdx;
+				OutPoints.Add(Apex);
+				FunnelL = FunnelR = Apex;
+				LeftIdx = RightIdx = ApexIdx;
+				i = ApexIdx;
+				continue;
+			}
+		}
+	}
+
+	if (!OutPoints.Last().Equals(End, 1e-3f))
+		OutPoints.Add(End);
+}
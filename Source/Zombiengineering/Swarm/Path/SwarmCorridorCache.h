@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Swarm/Path/SwarmPathCache.h"
+
+struct FNavigationPortalEdge;
+
+// Navmesh polygon corridors of recently solved paths. A requester standing in one of the
+// corridor's polygons can string-pull its own path through the remaining portals instead of
+// running A*. Game thread only; the path scheduler fills and reads it.
+class FSwarmCorridorCache
+{
+public:
+	struct FCorridor
+	{
+		TArray<NavNodeRef> Polys;
+		TArray<FVector>    Lefts;    // Lefts[i]/Rights[i] is the portal from Polys[i] to Polys[i + 1]
+		TArray<FVector>    Rights;
+		FVector End = FVector::ZeroVector;
+		double  Time = 0.0;
+	};
+
+	void Add(const FSwarmPathKey& Key, TConstArrayView<NavNodeRef> Polys, TConstArrayView<FNavigationPortalEdge> Portals,
+		const FVector& Start, const FVector& End, double Now);
+
+	// Looks through corridors toward Key.Goal starting in Key.Start or a neighbouring cell
+	// for one that passes through StartPoly. OutIndex is StartPoly's position in it.
+	const FCorridor* FindContaining(const FSwarmPathKey& Key, NavNodeRef StartPoly, double Now, int32& OutIndex) const;
+
+	void Empty();
+
+	FORCEINLINE int32 Num() const { return Corridors.Num(); }
+
+public:
+	int32  MaxCorridors = 2048;
+	double MaxAge       = 5.0;
+
+private:
+	TMap<FSwarmPathKey, FCorridor> Corridors;
+	TArray<FSwarmPathKey> Order;
+	int32 OrderHead = 0;
+};
+
+namespace SwarmPath
+{
+	// Simple stupid funnel: shortest path from Start to End through the portals, in 2D.
+	// Portals must be oriented so Right lies to the right of the direction of travel.
+	void StringPull(const FVector& Start, const FVector& End, TConstArrayView<FVector> Lefts,
+		TConstArrayView<FVector> Rights, TArray<FVector>& OutPoints);
+}
@@ -0,0 +1,226 @@
+#include "SwarmFlowFieldSubsystem.h"
+
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+
+namespace
+{
+	// E, NE, N, NW, W, SW, S, SE: odd entries are diagonals, (d + 4) & 7 is the opposite.
+	const FIntPoint GFlowOffsets[8] =
+	{
+		FIntPoint( 1,  0), FIntPoint( 1,  1), FIntPoint( 0,  1), FIntPoint(-1,  1),
+		FIntPoint(-1,  0), FIntPoint(-1, -1), FIntPoint( 0, -1), FIntPoint( 1, -1)
+	};
+}
+
+void USwarmFlowFieldSubsystem::Deinitialize()
+{
+	Reset();
+	WalkCache.Empty();
+	Super::Deinitialize();
+}
+
+void USwarmFlowFieldSubsystem::Reset()
+{
+	Front = FField();
+	Back  = FField();
+	Open.Empty();
+	bSolving = false;
+}
+
+void USwarmFlowFieldSubsystem::Tick(const FVector& Goal, int32& OutExpanded, int32& OutProjections)
+{
+	OutExpanded    = 0;
+	OutProjections = 0;
+
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData)
+		return;
+
+	const FIntPoint GoalCell = WorldToCell(Goal);
+
+	if (bSolving)
+	{
+		// Goal ran away from the solve in progress; the result would be stale on arrival.
+		const FIntPoint Drift = GoalCell - Back.GoalCell;
+		if (FMath::Max(FMath::Abs(Drift.X), FMath::Abs(Drift.Y)) > FMath::Max(2, HalfExtentCells / 4))
+		{
+			BeginSolve(Goal);
+		}
+	}
+	else if (!Front.bValid || Front.GoalCell != GoalCell)
+	{
+		BeginSolve(Goal);
+	}
+
+	if (!bSolving)
+		return;
+
+	int32 Expansions  = ExpansionsPerTick;
+	int32 Projections = ProjectionsPerTick;
+	const bool bDone  = ExpandSolve(NavSys, NavData, Expansions, Projections);
+
+	OutExpanded    = ExpansionsPerTick - Expansions;
+	OutProjections = ProjectionsPerTick - Projections;
+
+	if (bDone)
+	{
+		Back.bValid = true;
+		Swap(Front, Back);
+		Open.Reset();
+		bSolving = false;
+	}
+}
+
+void USwarmFlowFieldSubsystem::BeginSolve(const FVector& Goal)
+{
+	const int32 Half = FMath::Max(1, HalfExtentCells);
+	const int32 Size = 2 * Half + 1;
+	const int32 Num  = Size * Size;
+
+	Back.GoalCell = WorldToCell(Goal);
+	Back.Goal     = Goal;
+	Back.Origin   = Back.GoalCell - FIntPoint(Half, Half);
+	Back.Size     = Size;
+	Back.bValid   = false;
+
+	Back.Cost.Init(TNumericLimits<float>::Max(), Num);
+	Back.Dir.Init(NoDir, Num);
+	Back.Z.SetNumUninitialized(Num);
+
+	const int32 GoalIdx = Half * Size + Half;
+	Back.Cost[GoalIdx] = 0.f;
+	Back.Z[GoalIdx]    = Goal.Z;
+
+	Open.Reset();
+	Open.HeapPush({ 0.f, GoalIdx });
+	bSolving = true;
+}
+
+bool USwarmFlowFieldSubsystem::SampleWalkable(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+	const FIntPoint& Cell, float RefZ, int32& InOutProjections, FWalkSample& OutSample)
+{
+	if (const FWalkSample* Cached = WalkCache.Find(Cell))
+	{
+		OutSample = *Cached;
+		return true;
+	}
+
+	if (InOutProjections <= 0)
+		return false;
+	--InOutProjections;
+
+	const FVector Center((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, RefZ);
+	const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, MaxStepHeight * 2.f);
+
+	FWalkSample S;
+	FNavLocation Out;
+	if (NavSys->ProjectPointToNavigation(Center, Out, Extent, NavData))
+	{
+		S.bWalkable = true;
+		S.Z         = Out.Location.Z;
+	}
+
+	OutSample = WalkCache.Add(Cell, S);
+	return true;
+}
+
+bool USwarmFlowFieldSubsystem::ExpandSolve(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+	int32& InOutExpansions, int32& InOutProjections)
+{
+	const int32 Size = Back.Size;
+
+	while (Open.Num() > 0)
+	{
+		if (InOutExpansions <= 0)
+			return false;
+
+		const FOpenNode Node = Open.HeapTop();
+		if (Node.Cost > Back.Cost[Node.Index])
+		{
+			Open.HeapPopDiscard();
+			continue;
+		}
+
+		const FIntPoint Local(Node.Index % Size, Node.Index / Size);
+		const float     CurZ = Back.Z[Node.Index];
+
+		// Gather every neighbour before committing so a node is never half-expanded when the
+		// projection budget runs dry; whatever was sampled stays in the cache for next tick.
+		FWalkSample Nbr[8];
+		bool        bInside[8];
+		for (int32 d = 0; d < 8; ++d)
+		{
+			const FIntPoint L = Local + GFlowOffsets[d];
+			bInside[d] = (L.X >= 0 && L.Y >= 0 && L.X < Size && L.Y < Size);
+			if (bInside[d] && !SampleWalkable(NavSys, NavData, Back.Origin + L, CurZ, InOutProjections, Nbr[d]))
+				return false;
+		}
+
+		Open.HeapPopDiscard();
+		--InOutExpansions;
+
+		auto Passable = [&](int32 d)
+		{
+			return bInside[d] && Nbr[d].bWalkable && FMath::Abs(Nbr[d].Z - CurZ) <= MaxStepHeight;
+		};
+
+		for (int32 d = 0; d < 8; ++d)
+		{
+			if (!Passable(d))
+				continue;
+
+			const bool bDiagonal = (d & 1) != 0;
+			if (bDiagonal && (!Passable((d + 7) & 7) || !Passable((d + 1) & 7)))
+				continue;
+
+			const FIntPoint L    = Local + GFlowOffsets[d];
+			const int32     NIdx = L.Y * Size + L.X;
+			const float     NewCost = Node.Cost + (bDiagonal ? UE_SQRT_2 : 1.f);
+
+			if (NewCost < Back.Cost[NIdx])
+			{
+				Back.Cost[NIdx] = NewCost;
+				Back.Z[NIdx]    = Nbr[d].Z;
+				Back.Dir[NIdx]  = uint8((d + 4) & 7);
+				Open.HeapPush({ NewCost, NIdx });
+			}
+		}
+	}
+
+	return true;
+}
+
+bool USwarmFlowFieldSubsystem::SampleSteerTarget(const FVector& Pos, FVector& OutTarget) const
+{
+	if (!Front.bValid)
+		return false;
+
+	const int32 Size = Front.Size;
+	FIntPoint L = WorldToCell(Pos) - Front.Origin;
+	if (L.X < 0 || L.Y < 0 || L.X >= Size || L.Y >= Size)
+		return false;
+
+	int32 Idx = L.Y * Size + L.X;
+	if (Front.Cost[Idx] == TNumericLimits<float>::Max())
+		return false;
+
+	for (int32 k = 0; k < LookaheadCells && Front.Dir[Idx] != NoDir; ++k)
+	{
+		L  += GFlowOffsets[Front.Dir[Idx]];
+		Idx = L.Y * Size + L.X;
+	}
+
+	if (Front.Dir[Idx] == NoDir)
+	{
+		OutTarget = Front.Goal;
+		return true;
+	}
+
+	const FIntPoint Cell = Front.Origin + L;
+	OutTarget = FVector((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, Front.Z[Idx]);
+	return true;
+}
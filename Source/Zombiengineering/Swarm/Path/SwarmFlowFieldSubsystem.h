@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SwarmFlowFieldSubsystem.generated.h"
+
+class UNavigationSystemV1;
+class ANavigationData;
+
+// Single-source Dijkstra field over a navmesh-sampled 2.5D grid centred on the player.
+// Agents read the finished (front) field; a new solve is expanded into the back buffer a
+// slice per frame whenever the player changes cell, then swapped in.
+UCLASS()
+class USwarmFlowFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	// Game thread only. Advances the pending solve and starts a new one if the goal cell moved.
+	void Tick(const FVector& Goal, int32& OutExpanded, int32& OutProjections);
+
+	void Reset();
+
+	// Point to steer towards from Pos, a few cells downstream. False outside the field or
+	// on cells the solve never reached. Read-only, safe from parallel chunks.
+	bool SampleSteerTarget(const FVector& Pos, FVector& OutTarget) const;
+
+	FORCEINLINE bool HasField() const { return Front.bValid; }
+	FORCEINLINE bool IsSolving() const { return bSolving; }
+	FORCEINLINE int32 GetNumWalkSamples() const { return WalkCache.Num(); }
+
+public:
+	UPROPERTY() float CellSize         = 200.f;
+	UPROPERTY() int32 HalfExtentCells  = 96;
+	UPROPERTY() float MaxStepHeight    = 120.f;
+	UPROPERTY() int32 LookaheadCells   = 2;
+
+	UPROPERTY() int32 ExpansionsPerTick  = 6000;
+	UPROPERTY() int32 ProjectionsPerTick = 384;
+
+private:
+	struct FWalkSample
+	{
+		float Z = 0.f;
+		bool  bWalkable = false;
+	};
+
+	struct FField
+	{
+		FIntPoint Origin = FIntPoint::ZeroValue;
+		FIntPoint GoalCell = FIntPoint::ZeroValue;
+		FVector   Goal = FVector::ZeroVector;
+		int32     Size = 0;
+
+		TArray<float> Cost;
+		TArray<float> Z;
+		TArray<uint8> Dir;
+
+		bool bValid = false;
+	};
+
+	struct FOpenNode
+	{
+		float Cost;
+		int32 Index;
+		FORCEINLINE bool operator<(const FOpenNode& O) const { return Cost < O.Cost; }
+	};
+
+	static constexpr uint8 NoDir = 0xFF;
+
+	FORCEINLINE FIntPoint WorldToCell(const FVector& P) const
+	{
+		return FIntPoint(FMath::FloorToInt(P.X / CellSize), FMath::FloorToInt(P.Y / CellSize));
+	}
+
+	void BeginSolve(const FVector& Goal);
+	bool ExpandSolve(UNavigationSystemV1* NavSys, const ANavigationData* NavData, int32& InOutExpansions, int32& InOutProjections);
+	bool SampleWalkable(UNavigationSystemV1* NavSys, const ANavigationData* NavData, const FIntPoint& Cell, float RefZ, int32& InOutProjections, FWalkSample& OutSample);
+
+	FField Front;
+	FField Back;
+
+	TArray<FOpenNode> Open;
+	bool bSolving = false;
+
+	// Navmesh is static for the lifetime of a wave; samples are kept across solves.
+	TMap<FIntPoint, FWalkSample> WalkCache;
+};
@@ -0,0 +1,44 @@
+#include "SwarmNavVersion.h"
+
+#include "NavigationData.h"
+#include "NavMesh/RecastNavMesh.h"
+
+uint32 SwarmNav::ComputeVersionHash(const ANavigationData* NavData)
+{
+	if (!NavData)
+		return 0;
+
+	const FBox Bounds = NavData->GetBounds();
+	const FNavDataConfig& Cfg = NavData->GetConfig();
+
+	uint32 H = GetTypeHash(FVector3f(Bounds.Min));
+	H = HashCombine(H, GetTypeHash(FVector3f(Bounds.Max)));
+	H = HashCombine(H, GetTypeHash(Cfg.AgentRadius));
+	H = HashCombine(H, GetTypeHash(Cfg.AgentHeight));
+
+#if WITH_RECAST
+	// Bounds alone miss edits inside the level; fold in every polygon centre.
+	if (const ARecastNavMesh* Recast = Cast<const ARecastNavMesh>(NavData))
+	{
+		TArray<FNavPoly> Polys;
+		const int32 NumTiles = Recast->GetNavMeshTilesCount();
+		H = HashCombine(H, GetTypeHash(NumTiles));
+		for (int32 t = 0; t < NumTiles; ++t)
+		{
+			Polys.Reset();
+			if (!Recast->GetPolysInTile(t, Polys))
+				continue;
+
+			H = HashCombine(H, GetTypeHash(Polys.Num()));
+			for (const FNavPoly& P : Polys)
+			{
+				// Quantized so float noise between loads does not change the hash.
+				const FIntVector Q(FMath::RoundToInt(P.Center.X), FMath::RoundToInt(P.Center.Y), FMath::RoundToInt(P.Center.Z));
+				H = HashCombine(H, GetTypeHash(Q));
+			}
+		}
+	}
+#endif
+
+	return H;
+}
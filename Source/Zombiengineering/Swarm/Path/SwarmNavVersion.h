@@ -0,0 +1,12 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ANavigationData;
+
+namespace SwarmNav
+{
+	// Hash of the navmesh geometry, stable across sessions as long as the navmesh is not
+	// rebuilt differently. Used to reject precomputed data baked against another navmesh.
+	uint32 ComputeVersionHash(const ANavigationData* NavData);
+}
@@ -0,0 +1,160 @@
+#include "SwarmPathCache.h"
+
+FSwarmPathCache::FSwarmPathCache(FSwarmPathPool& InPool, int32 InMaxEntries)
+	: Pool(InPool)
+	, MaxEntries(FMath::Max(1, InMaxEntries))
+{
+	Index.Reserve(MaxEntries);
+}
+
+FSwarmPathHandle FSwarmPathCache::Find(const FSwarmPathKey& Key, double Now, double TTL)
+{
+	if (const int32* Slot = Index.Find(Key))
+	{
+		FEntry& E = Entries[*Slot];
+		if ((Now - E.Time) <= TTL && E.Path.IsValid())
+		{
+			E.Time = Now;
+			++E.Hits;
+			Touch(*Slot);
+			++Stats.Hits;
+			return E.Path;
+		}
+	}
+	++Stats.Misses;
+	return FSwarmPathHandle();
+}
+
+bool FSwarmPathCache::IsSolveCoolingDown(const FSwarmPathKey& Key, double Now, double Cooldown) const
+{
+	const int32* Slot = Index.Find(Key);
+	return Slot && (Now - Entries[*Slot].SolveTime) < Cooldown;
+}
+
+bool FSwarmPathCache::TryClaimSolve(const FSwarmPathKey& Key, double Now, double Cooldown, double InFlightTimeout, bool* bOutEvicted)
+{
+	if (const int32* Slot = Index.Find(Key))
+	{
+		const FEntry& E = Entries[*Slot];
+		const double SinceSolve = Now - E.SolveTime;
+		if (SinceSolve < Cooldown || (E.bSolveInFlight && SinceSolve < InFlightTimeout))
+			return false;
+	}
+
+	bool bEvicted = false;
+	const int32 Slot = AcquireSlot(Key, bEvicted);
+	Entries[Slot].SolveTime      = Now;
+	Entries[Slot].bSolveInFlight = true;
+	if (bOutEvicted) *bOutEvicted = bEvicted;
+	return true;
+}
+
+void FSwarmPathCache::ReleaseSolve(const FSwarmPathKey& Key)
+{
+	if (const int32* Slot = Index.Find(Key))
+	{
+		Entries[*Slot].bSolveInFlight = false;
+	}
+}
+
+bool FSwarmPathCache::Insert(const FSwarmPathKey& Key, FSwarmPathHandle Path, double Now)
+{
+	bool bEvicted = false;
+	const int32 Slot = AcquireSlot(Key, bEvicted);
+
+	FEntry& E   = Entries[Slot];
+	if (E.Path != Path)
+	{
+		Pool.Release(E.Path);
+	}
+	E.Path      = Path;
+	E.Time      = Now;
+	E.SolveTime = FMath::Max(E.SolveTime, Now);
+	E.bSolveInFlight = false;
+	return bEvicted;
+}
+
+int32 FSwarmPathCache::AcquireSlot(const FSwarmPathKey& Key, bool& bOutEvicted)
+{
+	bOutEvicted = false;
+
+	if (const int32* Existing = Index.Find(Key))
+	{
+		Touch(*Existing);
+		return *Existing;
+	}
+
+	// Entries are only ever recycled by eviction, so slots below MaxEntries are always in use.
+	int32 Slot = INDEX_NONE;
+	if (Index.Num() >= MaxEntries)
+	{
+		Slot = Tail;
+		Unlink(Slot);
+		Index.Remove(Entries[Slot].Key);
+		++Stats.Evictions;
+		bOutEvicted = true;
+	}
+	else
+	{
+		Slot = Entries.AddDefaulted();
+	}
+
+	FEntry& E   = Entries[Slot];
+	E.Key       = Key;
+	Pool.Release(E.Path);
+	E.Path      = FSwarmPathHandle();
+	E.Time      = 0.0;
+	E.SolveTime = 0.0;
+	E.bSolveInFlight = false;
+	E.Hits      = 0;
+
+	Index.Add(Key, Slot);
+	LinkFront(Slot);
+	return Slot;
+}
+
+void FSwarmPathCache::Empty()
+{
+	for (const auto& Pair : Index)
+	{
+		Pool.Release(Entries[Pair.Value].Path);
+	}
+	Entries.Reset();
+	Index.Reset();
+	Head = Tail = INDEX_NONE;
+}
+
+void FSwarmPathCache::CollectHot(TArray<FHotEntry>& Out) const
+{
+	for (const auto& Pair : Index)
+	{
+		const FEntry& E = Entries[Pair.Value];
+		if (E.Path.IsValid())
+			Out.Add({ E.Key, E.Path, E.Hits });
+	}
+}
+
+void FSwarmPathCache::Unlink(int32 Slot)
+{
+	FEntry& E = Entries[Slot];
+	if (E.Prev != INDEX_NONE) Entries[E.Prev].Next = E.Next; else Head = E.Next;
+	if (E.Next != INDEX_NONE) Entries[E.Next].Prev = E.Prev; else Tail = E.Prev;
+	E.Prev = E.Next = INDEX_NONE;
+}
+
+void FSwarmPathCache::LinkFront(int32 Slot)
+{
+	FEntry& E = Entries[Slot];
+	E.Prev = INDEX_NONE;
+	E.Next = Head;
+	if (Head != INDEX_NONE) Entries[Head].Prev = Slot;
+	Head = Slot;
+	if (Tail == INDEX_NONE) Tail = Slot;
+}
+
+void FSwarmPathCache::Touch(int32 Slot)
+{
+	if (Slot == Head) return;
+	Unlink(Slot);
+	LinkFront(Slot);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Swarm/Path/SwarmPathPool.h"
+
+struct FSwarmPathKey
+{
+	FIntVector Start, Goal;
+	bool operator==(const FSwarmPathKey& O) const { return Start == O.Start && Goal == O.Goal; }
+};
+
+FORCEINLINE uint32 GetTypeHash(const FSwarmPathKey& K)
+{
+	return HashCombine(GetTypeHash(K.Start), GetTypeHash(K.Goal));
+}
+
+namespace SwarmPath
+{
+	constexpr float CacheCellSize   = 500.f;
+	constexpr float CacheCellHeight = 200.f;
+
+	FORCEINLINE FIntVector QuantizeCell(const FVector& P)
+	{
+		return FIntVector(
+			FMath::FloorToInt(P.X / CacheCellSize),
+			FMath::FloorToInt(P.Y / CacheCellSize),
+			FMath::FloorToInt(P.Z / CacheCellHeight));
+	}
+
+	// True when B is one of the 26 cells around A.
+	FORCEINLINE bool IsNeighborCell(const FIntVector& A, const FIntVector& B)
+	{
+		const FIntVector D = B - A;
+		return D != FIntVector::ZeroValue && FMath::Abs(D.X) <= 1 && FMath::Abs(D.Y) <= 1 && FMath::Abs(D.Z) <= 1;
+	}
+}
+
+// Fixed-capacity path cache with an intrusive LRU list: lookup, refresh and eviction are O(1).
+// Entries own their pooled path and release it when replaced or evicted.
+class FSwarmPathCache
+{
+public:
+	struct FStats
+	{
+		uint64 Hits      = 0;
+		uint64 Misses    = 0;
+		uint64 Evictions = 0;
+	};
+
+	struct FHotEntry
+	{
+		FSwarmPathKey Key;
+		FSwarmPathHandle Path;
+		uint32 Hits;
+	};
+
+	FSwarmPathCache(FSwarmPathPool& InPool, int32 InMaxEntries = 8192);
+
+	FSwarmPathHandle Find(const FSwarmPathKey& Key, double Now, double TTL);
+
+	bool IsSolveCoolingDown(const FSwarmPathKey& Key, double Now, double Cooldown) const;
+
+	// Marks the key as being solved unless it is cooling down or a solve is still in flight
+	// (and younger than InFlightTimeout). Keys without an entry get an empty placeholder
+	// so concurrent requesters back off too.
+	bool TryClaimSolve(const FSwarmPathKey& Key, double Now, double Cooldown, double InFlightTimeout, bool* bOutEvicted = nullptr);
+
+	// Clears the in-flight mark of a solve that produced no path.
+	void ReleaseSolve(const FSwarmPathKey& Key);
+
+	// Returns true if an older entry had to be evicted.
+	bool Insert(const FSwarmPathKey& Key, FSwarmPathHandle Path, double Now);
+
+	void Empty();
+
+	// Every entry currently holding a path, with its lifetime hit count.
+	void CollectHot(TArray<FHotEntry>& Out) const;
+
+	FORCEINLINE int32 Num()         const { return Index.Num(); }
+	FORCEINLINE int32 GetCapacity() const { return MaxEntries; }
+	FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+private:
+	struct FEntry
+	{
+		FSwarmPathKey Key;
+		FSwarmPathHandle Path;
+		double Time      = 0.0;
+		double SolveTime = 0.0;
+		bool   bSolveInFlight = false;
+		uint32 Hits      = 0;
+		int32  Prev      = INDEX_NONE;
+		int32  Next      = INDEX_NONE;
+	};
+
+	int32 AcquireSlot(const FSwarmPathKey& Key, bool& bOutEvicted);
+	void Unlink(int32 Slot);
+	void LinkFront(int32 Slot);
+	void Touch(int32 Slot);
+
+	FSwarmPathPool& Pool;
+	const int32 MaxEntries;
+
+	TArray<FEntry>             Entries;
+	TMap<FSwarmPathKey, int32> Index;
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+
+	FStats Stats;
+};
@@ -0,0 +1,162 @@
+#include "SwarmPathCacheSubsystem.h"
+
+#include "Misc/ScopeLock.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Swarm/Path/SwarmNavVersion.h"
+
+static TAutoConsoleVariable<int32> CVarWarmStart(
+	TEXT("swarm.Path.WarmStart"), 0, TEXT("Load the path cache snapshot at begin play and save it at teardown 0/1"));
+
+void USwarmPathCacheSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PoolSS = Collection.InitializeDependency<USwarmPathPoolSubsystem>();
+
+	const uint32 NumShardsPow2 = FMath::RoundUpToPowerOfTwo(FMath::Clamp(NumShards, 1, 256));
+	const int32  PerShard      = FMath::Max(1, FMath::DivideAndRoundUp(MaxEntries, (int32)NumShardsPow2));
+
+	ShardMask  = NumShardsPow2 - 1;
+	ShardShift = 32 - FMath::Max(1u, FMath::FloorLog2(NumShardsPow2));
+
+	Shards.Reset(NumShardsPow2);
+	for (uint32 i = 0; i < NumShardsPow2; ++i)
+	{
+		TUniquePtr<FShard>& S = Shards.Add_GetRef(MakeUnique<FShard>());
+		S->Cache = MakeUnique<FSwarmPathCache>(PoolSS->GetPool(), PerShard);
+	}
+}
+
+void USwarmPathCacheSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!CVarWarmStart.GetValueOnGameThread())
+		return;
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+
+	// Remembered for the save: the navmesh may already be gone at teardown.
+	WarmNavHash = SwarmNav::ComputeVersionHash(NavData);
+	if (WarmNavHash != 0)
+	{
+		WarmStore.Load(GetWarmStorePath(), WarmNavHash);
+	}
+}
+
+FString USwarmPathCacheSubsystem::GetWarmStorePath() const
+{
+	const UWorld* World = GetWorld();
+	const FString MapName = World ? UWorld::RemovePIEPrefix(World->GetMapName()) : FString();
+	return FPaths::ProjectSavedDir() / TEXT("Swarm/WarmPaths") / (MapName + TEXT(".swcache"));
+}
+
+void USwarmPathCacheSubsystem::SaveWarmStore()
+{
+	TArray<FSwarmPathCache::FHotEntry> Hot;
+	for (const TUniquePtr<FShard>& S : Shards)
+	{
+		FScopeLock L(&S->CS);
+		S->Cache->CollectHot(Hot);
+	}
+	if (Hot.Num() == 0)
+		return;
+
+	Hot.Sort([](const FSwarmPathCache::FHotEntry& A, const FSwarmPathCache::FHotEntry& B) { return A.Hits > B.Hits; });
+
+	const FSwarmPathPool& Pool = GetPool();
+	TArray<TPair<FSwarmPathKey, FSwarmPathView>> Paths;
+	Paths.Reserve(FMath::Min(Hot.Num(), WarmMaxEntries));
+	for (const FSwarmPathCache::FHotEntry& E : Hot)
+	{
+		if (Paths.Num() >= WarmMaxEntries)
+			break;
+		if (const FSwarmPathView View = Pool.Resolve(E.Path))
+			Paths.Add({ E.Key, View });
+	}
+
+	TArray<uint8> Bytes;
+	FSwarmWarmPathStore::Serialize(Paths, WarmNavHash, Bytes);
+
+	// The mapping has to go before the file is replaced.
+	WarmStore.Unload();
+	FFileHelper::SaveArrayToFile(Bytes, *GetWarmStorePath());
+}
+
+void USwarmPathCacheSubsystem::Deinitialize()
+{
+	if (CVarWarmStart.GetValueOnGameThread() && WarmNavHash != 0)
+	{
+		SaveWarmStore();
+	}
+	WarmStore.Unload();
+	Shards.Reset();
+	Super::Deinitialize();
+}
+
+FSwarmPathHandle USwarmPathCacheSubsystem::Find(const FSwarmPathKey& Key, double Now, double InTTL)
+{
+	FShard& S = ShardFor(Key);
+	FScopeLock L(&S.CS);
+	return S.Cache->Find(Key, Now, InTTL);
+}
+
+bool USwarmPathCacheSubsystem::TryClaimSolve(const FSwarmPathKey& Key, double Now, bool* bOutEvicted)
+{
+	FShard& S = ShardFor(Key);
+	FScopeLock L(&S.CS);
+	return S.Cache->TryClaimSolve(Key, Now, SolveCooldown, SolveTimeout, bOutEvicted);
+}
+
+void USwarmPathCacheSubsystem::ReleaseSolve(const FSwarmPathKey& Key)
+{
+	FShard& S = ShardFor(Key);
+	FScopeLock L(&S.CS);
+	S.Cache->ReleaseSolve(Key);
+}
+
+bool USwarmPathCacheSubsystem::Insert(const FSwarmPathKey& Key, FSwarmPathHandle Path, double Now)
+{
+	FShard& S = ShardFor(Key);
+	FScopeLock L(&S.CS);
+	return S.Cache->Insert(Key, Path, Now);
+}
+
+void USwarmPathCacheSubsystem::Empty()
+{
+	for (const TUniquePtr<FShard>& S : Shards)
+	{
+		FScopeLock L(&S->CS);
+		S->Cache->Empty();
+	}
+}
+
+int32 USwarmPathCacheSubsystem::Num() const
+{
+	int32 Total = 0;
+	for (const TUniquePtr<FShard>& S : Shards)
+	{
+		FScopeLock L(&S->CS);
+		Total += S->Cache->Num();
+	}
+	return Total;
+}
+
+FSwarmPathCache::FStats USwarmPathCacheSubsystem::GetStats() const
+{
+	FSwarmPathCache::FStats Total;
+	for (const TUniquePtr<FShard>& S : Shards)
+	{
+		FScopeLock L(&S->CS);
+		const FSwarmPathCache::FStats& St = S->Cache->GetStats();
+		Total.Hits      += St.Hits;
+		Total.Misses    += St.Misses;
+		Total.Evictions += St.Evictions;
+	}
+	return Total;
+}
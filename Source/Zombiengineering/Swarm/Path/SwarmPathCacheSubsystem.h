@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HAL/CriticalSection.h"
+#include "Swarm/Path/SwarmPathCache.h"
+#include "Swarm/Path/SwarmPathPoolSubsystem.h"
+#include "Swarm/Path/SwarmPathTree.h"
+#include "Swarm/Path/SwarmCorridorCache.h"
+#include "Swarm/Path/SwarmWarmPathStore.h"
+#include "SwarmPathCacheSubsystem.generated.h"
+
+// Per-world path cache, split into independently locked shards so replanning can run on
+// parallel chunks.
+UCLASS()
+class USwarmPathCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	FSwarmPathHandle Find(const FSwarmPathKey& Key, double Now, double TTL);
+
+	bool TryClaimSolve(const FSwarmPathKey& Key, double Now, bool* bOutEvicted = nullptr);
+	void ReleaseSolve(const FSwarmPathKey& Key);
+
+	bool Insert(const FSwarmPathKey& Key, FSwarmPathHandle Path, double Now);
+
+	FORCEINLINE FSwarmPathPool& GetPool() const { return PoolSS->GetPool(); }
+
+	// Paths toward the current goal cell. Game thread only; the path scheduler owns updates.
+	FORCEINLINE FSwarmPathTree& GetGoalTree() { return GoalTree; }
+
+	// Polygon corridors of recent full solves. Game thread only, like the goal tree.
+	FORCEINLINE FSwarmCorridorCache& GetCorridors() { return Corridors; }
+
+	void Empty();
+
+	// Paths persisted from an earlier session (swarm.Path.WarmStart). Read-only, thread-safe.
+	FORCEINLINE TConstArrayView<FVector3f> FindWarm(const FSwarmPathKey& Key) const { return WarmStore.Find(Key); }
+
+	int32 Num() const;
+	FSwarmPathCache::FStats GetStats() const;
+
+public:
+	UPROPERTY() int32 MaxEntries = 8192;
+	UPROPERTY() int32 NumShards  = 16;
+
+	UPROPERTY() float  TTL           = 0.9f;
+	UPROPERTY() double SolveCooldown = 0.20;
+	UPROPERTY() double SolveTimeout  = 2.0;
+
+	// Most-hit entries written out at world teardown when warm start is on.
+	UPROPERTY() int32 WarmMaxEntries = 2048;
+
+private:
+	struct FShard
+	{
+		mutable FCriticalSection CS;
+		TUniquePtr<FSwarmPathCache> Cache;
+	};
+
+	FORCEINLINE FShard& ShardFor(const FSwarmPathKey& Key) const
+	{
+		const uint32 H = GetTypeHash(Key) * 0x9E3779B1u;
+		return *Shards[(H >> ShardShift) & ShardMask];
+	}
+
+	UPROPERTY(Transient) TObjectPtr<USwarmPathPoolSubsystem> PoolSS;
+
+	FString GetWarmStorePath() const;
+	void SaveWarmStore();
+
+	TArray<TUniquePtr<FShard>> Shards;
+	FSwarmPathTree GoalTree;
+	FSwarmCorridorCache Corridors;
+
+	FSwarmWarmPathStore WarmStore;
+	uint32 WarmNavHash = 0;
+	uint32 ShardShift = 28;
+	uint32 ShardMask  = 15;
+};
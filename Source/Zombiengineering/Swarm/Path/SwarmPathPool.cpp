@@ -0,0 +1,354 @@
+#include "SwarmPathPool.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Fills the box of Node, covering leaf blocks [Lo, Hi), and its children at 2n+1 / 2n+2.
+	FSwarmPathBounds BuildNode(const FVector* Points, int32 NumSegs, FSwarmPathBounds* Nodes, int32 Node, int32 Lo, int32 Hi)
+	{
+		FSwarmPathBounds B;
+		if (Hi - Lo == 1)
+		{
+			const int32 First = Lo * SwarmPath::SegmentsPerLeaf;
+			const int32 Last  = FMath::Min(NumSegs, First + SwarmPath::SegmentsPerLeaf);
+			B.Min = B.Max = FVector2f(Points[First]);
+			for (int32 k = First + 1; k <= Last; ++k)
+			{
+				const FVector2f P(Points[k]);
+				B.Min = FVector2f::Min(B.Min, P);
+				B.Max = FVector2f::Max(B.Max, P);
+			}
+		}
+		else
+		{
+			const int32 Mid = (Lo + Hi) / 2;
+			const FSwarmPathBounds L = BuildNode(Points, NumSegs, Nodes, 2 * Node + 1, Lo, Mid);
+			const FSwarmPathBounds R = BuildNode(Points, NumSegs, Nodes, 2 * Node + 2, Mid, Hi);
+			B.Min = FVector2f::Min(L.Min, R.Min);
+			B.Max = FVector2f::Max(L.Max, R.Max);
+		}
+		Nodes[Node] = B;
+		return B;
+	}
+
+	FORCEINLINE void ProjectSegment(const FSwarmPathView& View, int32 Seg, const FVector2f& P, int32& Best, float& BestDsq, float& BestAlong)
+	{
+		const FSwarmPathSegment& S = View.Segments[Seg];
+		const FVector2f A(View.Points[Seg]);
+		const float Along = FMath::Clamp(FVector2f::DotProduct(P - A, S.Tangent2D), 0.f, S.Length);
+		const float Dsq   = FVector2f::DistSquared(P, A + S.Tangent2D * Along);
+		if (Dsq < BestDsq)
+		{
+			Best = Seg;
+			BestDsq = Dsq;
+			BestAlong = Along;
+		}
+	}
+}
+
+int32 SwarmPath::ProjectOntoPath2D(const FSwarmPathView& View, const FVector& Pos, float* OutDistSq, float* OutAlong)
+{
+	if (!View || View.Num() < 2)
+		return INDEX_NONE;
+
+	const FVector2f P(Pos);
+	const int32 NumSegs = View.Num() - 1;
+
+	int32 Best = 0;
+	float BestDsq = TNumericLimits<float>::Max();
+	float BestAlong = 0.f;
+
+	if (!View.Bounds)
+	{
+		for (int32 s = 0; s < NumSegs; ++s)
+			ProjectSegment(View, s, P, Best, BestDsq, BestAlong);
+	}
+	else
+	{
+		// Depth-first, nearer child first, pruning boxes that can't beat the best so far.
+		struct FItem { int32 Node, Lo, Hi; };
+		FItem Stack[64];
+		int32 Top = 0;
+		Stack[Top++] = { 0, 0, FMath::DivideAndRoundUp(NumSegs, SegmentsPerLeaf) };
+
+		while (Top > 0)
+		{
+			const FItem It = Stack[--Top];
+			if (View.Bounds[It.Node].DistSquared(P) >= BestDsq)
+				continue;
+
+			if (It.Hi - It.Lo == 1)
+			{
+				const int32 First = It.Lo * SegmentsPerLeaf;
+				const int32 Last  = FMath::Min(NumSegs, First + SegmentsPerLeaf);
+				for (int32 s = First; s < Last; ++s)
+					ProjectSegment(View, s, P, Best, BestDsq, BestAlong);
+				continue;
+			}
+
+			const int32 Mid = (It.Lo + It.Hi) / 2;
+			FItem L{ 2 * It.Node + 1, It.Lo, Mid };
+			FItem R{ 2 * It.Node + 2, Mid, It.Hi };
+			if (View.Bounds[L.Node].DistSquared(P) < View.Bounds[R.Node].DistSquared(P))
+				Swap(L, R);
+			Stack[Top++] = L;
+			Stack[Top++] = R;
+		}
+	}
+
+	if (OutDistSq) *OutDistSq = BestDsq;
+	if (OutAlong)  *OutAlong  = BestAlong;
+	return Best;
+}
+
+FSwarmPathPool::~FSwarmPathPool()
+{
+	for (FVector*& Page : PointPages)
+	{
+		FMemory::Free(Page);
+		Page = nullptr;
+	}
+	for (FSwarmPathSegment*& Page : SegmentPages)
+	{
+		FMemory::Free(Page);
+		Page = nullptr;
+	}
+	for (FSwarmPathBounds*& Page : BoundsPages)
+	{
+		FMemory::Free(Page);
+		Page = nullptr;
+	}
+	for (FSlot*& Page : SlotPages)
+	{
+		delete[] Page;
+		Page = nullptr;
+	}
+}
+
+bool FSwarmPathPool::AllocateRange(int32 SizeClass, uint32& OutOffset)
+{
+	if (FreeRanges[SizeClass].Num() > 0)
+	{
+		OutOffset = FreeRanges[SizeClass].Pop(EAllowShrinking::No);
+		return true;
+	}
+
+	const int32 Capacity = 1 << (SizeClass + MinRangeLog2);
+	if (PageCursor + Capacity > PointsPerPage)
+	{
+		if (NumPointPages >= MaxPointPages)
+			return false;
+
+		PointPages[NumPointPages]   = (FVector*)FMemory::Malloc(sizeof(FVector) * PointsPerPage, 64);
+		SegmentPages[NumPointPages] = (FSwarmPathSegment*)FMemory::Malloc(sizeof(FSwarmPathSegment) * PointsPerPage, 64);
+		BoundsPages[NumPointPages]  = (FSwarmPathBounds*)FMemory::Malloc(sizeof(FSwarmPathBounds) * PointsPerPage, 64);
+		++NumPointPages;
+		PageCursor = 0;
+	}
+
+	OutOffset   = uint32(NumPointPages - 1) * PointsPerPage + PageCursor;
+	PageCursor += Capacity;
+	return true;
+}
+
+bool FSwarmPathPool::AllocateSlot(uint32& OutSlot)
+{
+	if (FreeSlots.Num() > 0)
+	{
+		OutSlot = FreeSlots.Pop(EAllowShrinking::No);
+		return true;
+	}
+
+	if (NumSlots > FSwarmPathHandle::SlotMask)
+		return false;
+
+	const uint32 Page = NumSlots / SlotsPerPage;
+	if (!SlotPages[Page])
+	{
+		SlotPages[Page] = new FSlot[SlotsPerPage];
+	}
+	OutSlot = NumSlots++;
+	return true;
+}
+
+FSwarmPathHandle FSwarmPathPool::AllocateStorage(int32 Num, FVector*& OutPoints, FSwarmPathSegment*& OutSegments, FSwarmPathBounds*& OutBounds)
+{
+	OutPoints   = nullptr;
+	OutSegments = nullptr;
+	OutBounds   = nullptr;
+	if (Num <= 0)
+		return FSwarmPathHandle();
+
+	ensureMsgf(Num <= PointsPerPage, TEXT("Swarm path of %d points truncated to %d"), Num, PointsPerPage);
+	Num = FMath::Min(Num, PointsPerPage);
+
+	const int32 SizeClass = FMath::Max(0, int32(FMath::CeilLogTwo(uint32(Num))) - MinRangeLog2);
+
+	FScopeLock L(&CS);
+
+	uint32 Offset = 0, Slot = 0;
+	if (!AllocateSlot(Slot))
+		return FSwarmPathHandle();
+	if (!AllocateRange(SizeClass, Offset))
+	{
+		FreeSlots.Add(Slot);
+		return FSwarmPathHandle();
+	}
+
+	// Not readable yet: Allocate sets LiveBit once the data is written.
+	FSlot& S = SlotPages[Slot / SlotsPerPage][Slot % SlotsPerPage];
+	S.Offset    = Offset;
+	S.Num       = Num;
+	S.SizeClass = uint8(SizeClass);
+	S.bRetired  = 0;
+	S.Refs.store(1, std::memory_order_relaxed);
+	++NumLive;
+
+	OutPoints   = GetPoints(Offset);
+	OutSegments = GetSegments(Offset);
+	OutBounds   = GetBounds(Offset);
+	return FSwarmPathHandle::Make(Slot, S.Tag.load(std::memory_order_relaxed));
+}
+
+FSwarmPathHandle FSwarmPathPool::Allocate(TConstArrayView<FVector> Points)
+{
+	FVector* Dst = nullptr;
+	FSwarmPathSegment* Segs = nullptr;
+	FSwarmPathBounds* Bounds = nullptr;
+	const FSwarmPathHandle Handle = AllocateStorage(Points.Num(), Dst, Segs, Bounds);
+	if (Dst)
+	{
+		const int32 Num = FMath::Min(Points.Num(), PointsPerPage);
+		FMemory::Memcpy(Dst, Points.GetData(), sizeof(FVector) * Num);
+		BuildSegments(Dst, Num, Segs);
+		if (Num > SwarmPath::MaxScannedPoints)
+			BuildBounds(Dst, Num, Bounds);
+
+		GetSlot(Handle.GetSlot())->Tag.store(Handle.GetGeneration() | LiveBit, std::memory_order_release);
+	}
+	return Handle;
+}
+
+void FSwarmPathPool::BuildBounds(const FVector* Points, int32 Num, FSwarmPathBounds* OutBounds)
+{
+	// A midpoint tree over B leaves uses fewer than 4B nodes, which fits in the path's own
+	// Num entries once there are more than MaxScannedPoints points.
+	const int32 NumSegs   = Num - 1;
+	const int32 NumLeaves = FMath::DivideAndRoundUp(NumSegs, SwarmPath::SegmentsPerLeaf);
+	checkSlow(4 * NumLeaves <= Num);
+	BuildNode(Points, NumSegs, OutBounds, 0, 0, NumLeaves);
+}
+
+void FSwarmPathPool::BuildSegments(const FVector* Points, int32 Num, FSwarmPathSegment* OutSegments)
+{
+	float CumDist = 0.f;
+	for (int32 i = 0; i < Num; ++i)
+	{
+		FSwarmPathSegment& S = OutSegments[i];
+		S = FSwarmPathSegment();
+		S.CumDist = CumDist;
+		if (i + 1 >= Num)
+			break;
+
+		const FVector2f V01(Points[i + 1] - Points[i]);
+		const float L01Sq = V01.SquaredLength();
+		if (L01Sq <= 1e-6f)
+			continue;
+
+		const float InvL01 = FMath::InvSqrt(L01Sq);
+		S.Tangent2D = V01 * InvL01;
+		S.Length    = L01Sq * InvL01;
+		CumDist    += S.Length;
+
+		if (i + 2 < Num)
+		{
+			const FVector2f V12(Points[i + 2] - Points[i + 1]);
+			const float L12Sq = V12.SquaredLength();
+			if (L12Sq > 1e-6f)
+			{
+				const float SinTh = FMath::Abs(V01 ^ V12) * InvL01 * FMath::InvSqrt(L12Sq);
+				S.Curvature = SinTh * InvL01;
+			}
+		}
+	}
+}
+
+void FSwarmPathPool::AddRef(FSwarmPathHandle Handle)
+{
+	// A live slot can't be reclaimed mid-frame, so a count at zero here just pulls the path
+	// back out of the retired list; Reclaim rechecks it.
+	if (FSlot* S = FindLive(Handle))
+	{
+		S->Refs.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void FSwarmPathPool::Release(FSwarmPathHandle Handle)
+{
+	FSlot* S = FindLive(Handle);
+	if (!S || S->Refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		return;
+
+	FScopeLock L(&CS);
+	if (!S->bRetired)
+	{
+		S->bRetired = 1;
+		Retired.Add(Handle.GetSlot());
+	}
+}
+
+void FSwarmPathPool::Reclaim()
+{
+	check(IsInGameThread());
+
+	FScopeLock L(&CS);
+
+	for (const uint32 SlotIdx : Retired)
+	{
+		FSlot& S = SlotPages[SlotIdx / SlotsPerPage][SlotIdx % SlotsPerPage];
+		S.bRetired = 0;
+		if (S.Refs.load(std::memory_order_acquire) > 0)
+			continue;
+
+		// Bump the generation before the range goes back on the free list so stale handles
+		// stop resolving ahead of any reuse.
+		uint32 Gen = (S.Tag.load(std::memory_order_relaxed) + 1) & FSwarmPathHandle::GenMask;
+		if (Gen == 0)
+			Gen = 1;
+		S.Tag.store(Gen, std::memory_order_release);
+
+		FreeRanges[S.SizeClass].Add(S.Offset);
+		FreeSlots.Add(SlotIdx);
+		--NumLive;
+	}
+	Retired.Reset();
+}
+
+FSwarmPathView FSwarmPathPool::Resolve(FSwarmPathHandle Handle) const
+{
+	const FSlot* S = FindLive(Handle);
+	if (!S)
+		return FSwarmPathView();
+
+	return FSwarmPathView{ GetPoints(S->Offset), GetSegments(S->Offset),
+		S->Num > SwarmPath::MaxScannedPoints ? GetBounds(S->Offset) : nullptr, S->Num };
+}
+
+int32 FSwarmPathPool::GetNumLive() const
+{
+	FScopeLock L(&CS);
+	return NumLive;
+}
+
+int32 FSwarmPathPool::GetNumRetired() const
+{
+	FScopeLock L(&CS);
+	return Retired.Num();
+}
+
+SIZE_T FSwarmPathPool::GetReservedBytes() const
+{
+	FScopeLock L(&CS);
+	return SIZE_T(NumPointPages) * PointsPerPage * (sizeof(FVector) + sizeof(FSwarmPathSegment) + sizeof(FSwarmPathBounds));
+}
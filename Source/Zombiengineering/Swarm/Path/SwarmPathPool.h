@@ -0,0 +1,187 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include <atomic>
+
+// 20-bit slot index, 12-bit generation. Zero is never a valid handle.
+struct FSwarmPathHandle
+{
+	static constexpr uint32 SlotBits = 20;
+	static constexpr uint32 SlotMask = (1u << SlotBits) - 1;
+	static constexpr uint32 GenMask  = (1u << (32 - SlotBits)) - 1;
+
+	uint32 Value = 0;
+
+	FORCEINLINE bool   IsValid()       const { return Value != 0; }
+	FORCEINLINE uint32 GetSlot()       const { return Value & SlotMask; }
+	FORCEINLINE uint32 GetGeneration() const { return Value >> SlotBits; }
+
+	FORCEINLINE static FSwarmPathHandle Make(uint32 Slot, uint32 Generation)
+	{
+		return FSwarmPathHandle{ (Generation << SlotBits) | (Slot & SlotMask) };
+	}
+
+	FORCEINLINE bool operator==(const FSwarmPathHandle& O) const { return Value == O.Value; }
+	FORCEINLINE bool operator!=(const FSwarmPathHandle& O) const { return Value != O.Value; }
+};
+
+// Geometry of the segment from point i to point i + 1, measured in 2D. The last point's
+// entry is zero apart from CumDist.
+struct FSwarmPathSegment
+{
+	FVector2f Tangent2D = FVector2f::ZeroVector;
+	float     Length    = 0.f;
+	float     Curvature = 0.f;   // turn into the next segment, |sin| / Length
+	float     CumDist   = 0.f;   // path distance from point 0 to point i
+};
+
+// 2D box over a run of segments; node of a path's segment hierarchy.
+struct FSwarmPathBounds
+{
+	FVector2f Min;
+	FVector2f Max;
+
+	FORCEINLINE float DistSquared(const FVector2f& P) const
+	{
+		const float Dx = FMath::Max3(Min.X - P.X, 0.f, P.X - Max.X);
+		const float Dy = FMath::Max3(Min.Y - P.Y, 0.f, P.Y - Max.Y);
+		return Dx * Dx + Dy * Dy;
+	}
+};
+
+struct FSwarmPathView
+{
+	const FVector* Points = nullptr;
+	const FSwarmPathSegment* Segments = nullptr;
+	const FSwarmPathBounds* Bounds = nullptr;   // null for short paths, which are scanned
+	int32 Count = 0;
+
+	FORCEINLINE explicit operator bool() const { return Points != nullptr; }
+	FORCEINLINE int32 Num() const { return Count; }
+	FORCEINLINE const FVector& operator[](int32 i) const { checkSlow(i >= 0 && i < Count); return Points[i]; }
+	FORCEINLINE const FSwarmPathSegment& Segment(int32 i) const { checkSlow(i >= 0 && i < Count); return Segments[i]; }
+	FORCEINLINE float Length() const { return Count > 0 ? Segments[Count - 1].CumDist : 0.f; }
+};
+
+namespace SwarmPath
+{
+	// Paths with more points than this get a segment hierarchy: a midpoint-split tree of
+	// boxes over leaves of SegmentsPerLeaf segments, heap-ordered from the root.
+	constexpr int32 SegmentsPerLeaf   = 8;
+	constexpr int32 MaxScannedPoints  = 2 * SegmentsPerLeaf;
+
+	// Closest segment to Pos in 2D, projecting onto segments rather than points. Returns the
+	// segment index (segment k runs View[k] -> View[k + 1]) or INDEX_NONE for an empty path.
+	int32 ProjectOntoPath2D(const FSwarmPathView& View, const FVector& Pos, float* OutDistSq = nullptr, float* OutAlong = nullptr);
+}
+
+// Path points for the whole swarm in fixed-size pages, addressed through generation-checked
+// handles. Segment geometry and the segment hierarchy are computed once on allocation
+// and stored in parallel pages. Allocation and the last release take a lock; Resolve is
+// lock-free because pages are never moved or freed while the pool lives. Paths are
+// reference counted: the cache entry and every agent following a path hold a reference,
+// and a path whose count reaches zero stays readable until the next Reclaim. Reclaim must
+// run outside Mass processing, so a handle resolved during a frame never sees reused
+// points, segments or bounds.
+class FSwarmPathPool
+{
+public:
+	static constexpr int32 PointsPerPage = 16384;
+	static constexpr int32 MaxPointPages = 256;
+	static constexpr int32 SlotsPerPage  = 1024;
+	static constexpr int32 MaxSlotPages  = (FSwarmPathHandle::SlotMask + 1) / SlotsPerPage;
+	static constexpr int32 MinRangeLog2  = 2;
+	static constexpr int32 NumSizeClasses = 13;
+
+	FSwarmPathPool() = default;
+	~FSwarmPathPool();
+
+	FSwarmPathPool(const FSwarmPathPool&) = delete;
+	FSwarmPathPool& operator=(const FSwarmPathPool&) = delete;
+
+	// The returned handle carries one reference, owned by the caller.
+	FSwarmPathHandle Allocate(TConstArrayView<FVector> Points);
+
+	// Safe from parallel processors. AddRef on a stale handle is ignored.
+	void AddRef(FSwarmPathHandle Handle);
+
+	// Drops a reference. The last one schedules the path for reclamation; the handle stays
+	// resolvable until Reclaim.
+	void Release(FSwarmPathHandle Handle);
+
+	// Frees every path with no references left. Game thread only, between Mass phases.
+	void Reclaim();
+
+	FSwarmPathView Resolve(FSwarmPathHandle Handle) const;
+
+	int32 GetNumLive()     const;
+	int32 GetNumRetired()  const;
+	SIZE_T GetReservedBytes() const;
+
+private:
+	// Generation in the low bits, LiveBit set while the path is readable.
+	static constexpr uint32 LiveBit = 1u << 16;
+
+	struct FSlot
+	{
+		uint32 Offset    = 0;
+		int32  Num       = 0;
+		std::atomic<uint32> Tag { 1 };   // stored with release once Offset/Num and the data are written
+		std::atomic<int32>  Refs { 0 };
+		uint8  SizeClass = 0;
+		uint8  bRetired  = 0;             // queued for Reclaim; guarded by CS
+	};
+
+	FORCEINLINE FSlot* GetSlot(uint32 Slot) const
+	{
+		FSlot* Page = SlotPages[Slot / SlotsPerPage];
+		return Page ? &Page[Slot % SlotsPerPage] : nullptr;
+	}
+
+	// Slot of a handle whose path is still readable, or null.
+	FORCEINLINE FSlot* FindLive(FSwarmPathHandle Handle) const
+	{
+		FSlot* S = Handle.IsValid() ? GetSlot(Handle.GetSlot()) : nullptr;
+		return (S && S->Tag.load(std::memory_order_acquire) == (Handle.GetGeneration() | LiveBit)) ? S : nullptr;
+	}
+
+	FORCEINLINE FVector* GetPoints(uint32 Offset) const
+	{
+		return PointPages[Offset / PointsPerPage] + (Offset % PointsPerPage);
+	}
+
+	FORCEINLINE FSwarmPathSegment* GetSegments(uint32 Offset) const
+	{
+		return SegmentPages[Offset / PointsPerPage] + (Offset % PointsPerPage);
+	}
+
+	FORCEINLINE FSwarmPathBounds* GetBounds(uint32 Offset) const
+	{
+		return BoundsPages[Offset / PointsPerPage] + (Offset % PointsPerPage);
+	}
+
+	FSwarmPathHandle AllocateStorage(int32 Num, FVector*& OutPoints, FSwarmPathSegment*& OutSegments, FSwarmPathBounds*& OutBounds);
+	static void BuildSegments(const FVector* Points, int32 Num, FSwarmPathSegment* OutSegments);
+	static void BuildBounds(const FVector* Points, int32 Num, FSwarmPathBounds* OutBounds);
+
+	bool AllocateRange(int32 SizeClass, uint32& OutOffset);
+	bool AllocateSlot(uint32& OutSlot);
+
+	mutable FCriticalSection CS;
+
+	FVector* PointPages[MaxPointPages] = {};
+	FSwarmPathSegment* SegmentPages[MaxPointPages] = {};
+	FSwarmPathBounds*  BoundsPages[MaxPointPages]  = {};
+	FSlot*   SlotPages[MaxSlotPages]   = {};
+
+	int32  NumPointPages = 0;
+	int32  PageCursor    = PointsPerPage;
+	uint32 NumSlots      = 1;
+	int32  NumLive       = 0;
+
+	TArray<uint32>   FreeRanges[NumSizeClasses];
+	TArray<uint32>   FreeSlots;
+	TArray<uint32>   Retired;
+};
@@ -0,0 +1,29 @@
+#include "SwarmPathPoolSubsystem.h"
+
+#include "Engine/World.h"
+#include "MassEntitySubsystem.h"
+
+void USwarmPathPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USwarmPathPoolSubsystem::OnWorldPostActorTick);
+}
+
+void USwarmPathPoolSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	Super::Deinitialize();
+}
+
+void USwarmPathPoolSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick, float)
+{
+	if (InWorld != GetWorld())
+		return;
+
+	// Post actor tick is past the last Mass phase; parallel readers are done with this frame.
+	const UMassEntitySubsystem* Mass = InWorld->GetSubsystem<UMassEntitySubsystem>();
+	if (ensure(!Mass || !Mass->GetEntityManager().IsProcessing()))
+	{
+		Pool.Reclaim();
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Swarm/Path/SwarmPathPool.h"
+#include "SwarmPathPoolSubsystem.generated.h"
+
+UCLASS()
+class USwarmPathPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	FORCEINLINE FSwarmPathPool& GetPool() { return Pool; }
+	FORCEINLINE const FSwarmPathPool& GetPool() const { return Pool; }
+
+private:
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	FSwarmPathPool Pool;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,543 @@
+#include "SwarmPathSchedulerSubsystem.h"
+
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavMesh/NavMeshPath.h"
+#include "Swarm/Path/SwarmPathCacheSubsystem.h"
+#include "Swarm/Path/SwarmRouteTableSubsystem.h"
+
+void USwarmPathSchedulerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	CacheSS  = Collection.InitializeDependency<USwarmPathCacheSubsystem>();
+	RoutesSS = Collection.InitializeDependency<USwarmRouteTableSubsystem>();
+
+	for (std::atomic<uint64>& Word : InFlightKeys)
+		Word.store(0, std::memory_order_relaxed);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USwarmPathSchedulerSubsystem::OnWorldPostActorTick);
+}
+
+void USwarmPathSchedulerSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	// Outstanding nav queries hold weak delegates and complete into nothing.
+	Mailbox.Empty();
+	Completions.Empty();
+	Queue.Reset();
+	NumPending.store(0, std::memory_order_relaxed);
+	InFlight = 0;
+	Super::Deinitialize();
+}
+
+bool USwarmPathSchedulerSubsystem::TryClaimInFlight(const FSwarmPathKey& Key)
+{
+	uint32 Word; uint64 Mask;
+	InFlightBit(Key, Word, Mask);
+	return (InFlightKeys[Word].fetch_or(Mask, std::memory_order_acq_rel) & Mask) == 0;
+}
+
+void USwarmPathSchedulerSubsystem::ClearInFlight(const FSwarmPathKey& Key)
+{
+	uint32 Word; uint64 Mask;
+	InFlightBit(Key, Word, Mask);
+	InFlightKeys[Word].fetch_and(~Mask, std::memory_order_release);
+}
+
+int32 USwarmPathSchedulerSubsystem::SubmitBatch(TConstArrayView<FSwarmPathRequest> Batch, double Now, int32* OutEvictions,
+	TArrayView<bool> OutAccepted)
+{
+	check(OutAccepted.Num() == 0 || OutAccepted.Num() == Batch.Num());
+	if (Batch.Num() == 0 || !CacheSS)
+		return 0;
+
+	int32 Accepted = 0, Deduped = 0, Rejected = 0, Evicted = 0;
+
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		const FSwarmPathRequest& R = Batch[i];
+		if (OutAccepted.Num() > 0)
+			OutAccepted[i] = false;
+
+		if (!TryClaimInFlight(R.Key))
+		{
+			++Deduped;
+			continue;
+		}
+
+		if (NumPending.fetch_add(1, std::memory_order_relaxed) >= MaxQueued)
+		{
+			NumPending.fetch_sub(1, std::memory_order_relaxed);
+			ClearInFlight(R.Key);
+			++Rejected;
+			continue;
+		}
+
+		bool bEvicted = false;
+		if (!CacheSS->TryClaimSolve(R.Key, Now, &bEvicted))
+		{
+			NumPending.fetch_sub(1, std::memory_order_relaxed);
+			ClearInFlight(R.Key);
+			++Deduped;
+			continue;
+		}
+		if (bEvicted)
+			++Evicted;
+
+		Mailbox.Enqueue({ R, Now, 0.f });
+		if (OutAccepted.Num() > 0)
+			OutAccepted[i] = true;
+		++Accepted;
+	}
+
+	NumSubmitted.fetch_add(Batch.Num(), std::memory_order_relaxed);
+	NumDeduped.fetch_add(Deduped, std::memory_order_relaxed);
+	NumRejected.fetch_add(Rejected, std::memory_order_relaxed);
+	NumEvicted.fetch_add(Evicted, std::memory_order_relaxed);
+	if (OutEvictions)
+		*OutEvictions += Evicted;
+	return Accepted;
+}
+
+void USwarmPathSchedulerSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick, float)
+{
+	if (InWorld == GetWorld())
+	{
+		Dispatch();
+	}
+}
+
+bool USwarmPathSchedulerSubsystem::SolveFunnel(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+	const FSwarmPathRequest& R, double Now, TArray<FVector>& OutPoints) const
+{
+	FNavLocation StartNav;
+	if (!NavSys->ProjectPointToNavigation(R.Start, StartNav, FVector(100, 100, 200), NavData) || StartNav.NodeRef == INVALID_NAVNODEREF)
+		return false;
+
+	int32 Index = INDEX_NONE;
+	const FSwarmCorridorCache::FCorridor* C = CacheSS->GetCorridors().FindContaining(R.Key, StartNav.NodeRef, Now, Index);
+	if (!C)
+		return false;
+
+	SwarmPath::StringPull(StartNav.Location, C->End,
+		TConstArrayView<FVector>(C->Lefts).RightChop(Index),
+		TConstArrayView<FVector>(C->Rights).RightChop(Index), OutPoints);
+	return OutPoints.Num() >= 2;
+}
+
+bool USwarmPathSchedulerSubsystem::SolveJoin(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+	const FSwarmPathRequest& R, double Now, TArray<FVector>& OutPoints, int32& OutLegSegments, FAsyncSolve& OutAsync) const
+{
+	FNavLocation StartNav;
+	if (!NavSys->ProjectPointToNavigation(R.Start, StartNav, FVector(100, 100, 200), NavData))
+		return false;
+	const FVector From = StartNav.Location;
+
+	TArray<FSwarmPathTree::FJoin, TInlineAllocator<FSwarmPathTree::MaxJoins>> Joins;
+	CacheSS->GetGoalTree().FindJoins(From, JoinRadius, CacheSS->GetPool(), Now, Joins);
+	if (Joins.Num() == 0)
+		return false;
+
+	auto AppendSuffix = [](const FSwarmPathTree::FJoin& J, TArray<FVector>& Out)
+	{
+		Out.Add(J.Pos);
+		for (int32 k = J.Segment + 1; k < J.View.Num(); ++k)
+			Out.Add(J.View[k]);
+	};
+
+	// A straight navmesh raycast to any candidate is the cheapest connection, and finishes
+	// inline.
+	for (const FSwarmPathTree::FJoin& J : Joins)
+	{
+		FVector Hit;
+		if (!NavData->Raycast(From, J.Pos, Hit, nullptr))
+		{
+			OutPoints.Add(From);
+			AppendSuffix(J, OutPoints);
+			OutLegSegments = 1;
+			return true;
+		}
+	}
+
+	// Otherwise a short local search to the best one, as long as it does not wander off.
+	// The suffix is copied now; the tree may move on before the search lands.
+	const FSwarmPathTree::FJoin& Best = Joins[0];
+	FLeg& Leg = OutAsync.Legs.AddDefaulted_GetRef();
+	Leg.From      = From;
+	Leg.To        = Best.Pos;
+	Leg.MaxLength = 2.f * JoinRadius;
+	for (int32 k = Best.Segment + 1; k < Best.View.Num(); ++k)
+		Leg.After.Add(Best.View[k]);
+	OutAsync.Kind = ESolveKind::Join;
+	return false;
+}
+
+bool USwarmPathSchedulerSubsystem::PlanRouted(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+	const FSwarmPathRequest& R, FAsyncSolve& OutAsync) const
+{
+	const FSwarmRouteTable* Table = RoutesSS ? RoutesSS->GetTable() : nullptr;
+	if (!Table)
+		return false;
+
+	const int32 FromRegion = Table->RegionAt(R.Start);
+	const int32 ToRegion   = Table->RegionAt(R.Goal);
+	if (FromRegion == INDEX_NONE || ToRegion == INDEX_NONE)
+		return false;
+
+	TArray<int32, TInlineAllocator<64>> Route;
+	Route.Add(FromRegion);
+	while (Route.Last() != ToRegion)
+	{
+		const int32 Hop = Table->NextHop(Route.Last(), ToRegion);
+		if (Hop == INDEX_NONE || Route.Num() > Table->Num())
+			return false;
+		Route.Add(Hop);
+	}
+
+	// Routes of a few regions are cheaper to solve directly.
+	if (Route.Num() < 4)
+		return false;
+
+	// Local search into the second region, precomputed anchor-to-anchor paths through the
+	// middle, local search from the second-to-last region to the goal.
+	FLeg First;
+	for (int32 k = 1; k + 2 < Route.Num(); ++k)
+	{
+		const TConstArrayView<FVector3f> Edge = Table->GetEdgePath(Route[k], Route[k + 1]);
+		if (Edge.Num() < 2)
+			return false;
+		for (int32 p = 1; p < Edge.Num(); ++p)
+			First.After.Add(FVector(Edge[p]));
+	}
+
+	FNavLocation StartNav;
+	First.From = NavSys->ProjectPointToNavigation(R.Start, StartNav, FVector(100, 100, 200), NavData)
+		? StartNav.Location : R.Start;
+	First.To   = Table->GetAnchor(Route[1]);
+
+	FLeg Last;
+	Last.From       = Table->GetAnchor(Route[Route.Num() - 2]);
+	Last.To         = R.Goal;
+	Last.bSkipFirst = true;
+
+	OutAsync.Legs.Add(MoveTemp(First));
+	OutAsync.Legs.Add(MoveTemp(Last));
+	OutAsync.Kind = ESolveKind::Routed;
+	return true;
+}
+
+bool USwarmPathSchedulerSubsystem::PlanRepair(const FSwarmPathRequest& R, const FSwarmPathView& Prev, FAsyncSolve& OutAsync) const
+{
+	if (Prev.Num() < 2)
+		return false;
+
+	// Splice at the last point at least RepairBackoff (along the path) before the old goal.
+	int32  Splice = Prev.Num() - 1;
+	double Walked = 0.0;
+	while (Splice > 0 && Walked < RepairBackoff)
+	{
+		Walked += FVector::Dist(Prev[Splice], Prev[Splice - 1]);
+		--Splice;
+	}
+
+	// Resume the old path at the end of the segment nearest the requester; if that is already
+	// past the splice there is no prefix worth keeping.
+	const int32 Resume = SwarmPath::ProjectOntoPath2D(Prev, R.Start) + 1;
+	if (Resume > Splice)
+		return false;
+
+	// The prefix is copied now; the old path may be gone by the time the search lands.
+	OutAsync.Points.Reserve(Splice - Resume + 2);
+	OutAsync.Points.Add(R.Start);
+	for (int32 k = Resume; k <= Splice; ++k)
+		OutAsync.Points.Add(Prev[k]);
+
+	FLeg& Leg = OutAsync.Legs.AddDefaulted_GetRef();
+	Leg.From       = Prev[Splice];
+	Leg.To         = R.Goal;
+	Leg.bSkipFirst = true;
+	OutAsync.Kind  = ESolveKind::Repair;
+	return true;
+}
+
+void USwarmPathSchedulerSubsystem::PlanFull(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+	const FSwarmPathRequest& R, FAsyncSolve& OutAsync) const
+{
+	FNavLocation StartNav;
+	FLeg& Leg = OutAsync.Legs.AddDefaulted_GetRef();
+	Leg.From = NavSys->ProjectPointToNavigation(R.Start, StartNav, FVector(100, 100, 200), NavData)
+		? StartNav.Location : R.Start;
+	Leg.To            = R.Goal;
+	Leg.bHierarchical = R.bHierarchical;
+	Leg.bAllowPartial = true;
+	OutAsync.Kind     = ESolveKind::Full;
+}
+
+void USwarmPathSchedulerSubsystem::IssueLeg(const TSharedRef<FAsyncSolve>& Solve)
+{
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData)
+	{
+		Completions.Enqueue({ Solve, false });
+		return;
+	}
+
+	const FNavDataConfig& Cfg = NavData->GetConfig();
+	FNavAgentProperties AgentProps;
+	AgentProps.AgentRadius = Cfg.AgentRadius;
+	AgentProps.AgentHeight = Cfg.AgentHeight;
+
+	const FLeg& Leg = Solve->Legs[Solve->Leg];
+	const FPathFindingQuery PFQ(nullptr, *NavData, Leg.From, Leg.To);
+
+	const uint32 QueryId = NavSys->FindPathAsync(AgentProps, PFQ,
+		FNavPathQueryDelegate::CreateWeakLambda(this,
+			[this, Solve](uint32, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+			{
+				OnLegDone(Solve, Result, Path);
+			}),
+		Leg.bHierarchical ? EPathFindingMode::Hierarchical : EPathFindingMode::Regular);
+
+	if (QueryId == INVALID_NAVQUERYID)
+	{
+		Completions.Enqueue({ Solve, false });
+	}
+}
+
+void USwarmPathSchedulerSubsystem::Restart(const TSharedRef<FAsyncSolve>& Solve)
+{
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData)
+	{
+		Completions.Enqueue({ Solve, false });
+		return;
+	}
+
+	Solve->Points.Reset();
+	Solve->Legs.Reset();
+	Solve->Leg = 0;
+	Solve->JoinLegSegments = 0;
+	PlanFull(NavSys, NavData, Solve->Request, *Solve);
+	IssueLeg(Solve);
+}
+
+void USwarmPathSchedulerSubsystem::OnLegDone(const TSharedRef<FAsyncSolve>& Solve, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FLeg& Leg = Solve->Legs[Solve->Leg];
+
+	const bool bFound = Result == ENavigationQueryResult::Success && Path.IsValid() && Path->GetPathPoints().Num() >= 2
+		&& (Leg.bAllowPartial || !Path->IsPartial())
+		&& (Leg.MaxLength <= 0.f || Path->GetLength() <= Leg.MaxLength);
+
+	if (!bFound)
+	{
+		// Reuse methods fall back to searching the whole way, as the inline cascade used to.
+		if (Solve->Kind != ESolveKind::Full)
+			Restart(Solve);
+		else
+			Completions.Enqueue({ Solve, false });
+		return;
+	}
+
+	const TArray<FNavPathPoint>& Pts = Path->GetPathPoints();
+	for (int32 k = Leg.bSkipFirst ? 1 : 0; k < Pts.Num(); ++k)
+		Solve->Points.Add(Pts[k].Location);
+	if (Solve->Kind == ESolveKind::Join)
+		Solve->JoinLegSegments = Pts.Num() - 1;
+	Solve->Points.Append(MoveTemp(Leg.After));
+	Solve->LastPath = Path;
+
+	if (++Solve->Leg < Solve->Legs.Num())
+	{
+		IssueLeg(Solve);
+		return;
+	}
+	Completions.Enqueue({ Solve, true });
+}
+
+void USwarmPathSchedulerSubsystem::Finish(const FSwarmPathKey& Key, double Now, int32 TreeSegments, bool bSuccess)
+{
+	FSwarmPathPool& Pool = CacheSS->GetPool();
+	const FSwarmPathHandle Handle = (bSuccess && Scratch.Num() >= 2) ? Pool.Allocate(Scratch) : FSwarmPathHandle();
+
+	if (Handle.IsValid() && bJoinPathTree)
+	{
+		// Newest goal wins the tree. Joined paths only add their connecting leg when the
+		// suffix they joined is still in there.
+		FSwarmPathTree& Tree = CacheSS->GetGoalTree();
+		const bool bTreeGoal = Tree.HasGoal() && Tree.GetGoalCell() == Key.Goal;
+		if (!bTreeGoal)
+			Tree.Reset(Key.Goal);
+		Tree.AddPath(Handle, Pool.Resolve(Handle), Now, bTreeGoal ? TreeSegments : MAX_int32);
+	}
+
+	if (Handle.IsValid())
+	{
+		CacheSS->Insert(Key, Handle, Now);
+		++Current.Solves;
+	}
+	else
+	{
+		CacheSS->ReleaseSolve(Key);
+		++Current.Failures;
+	}
+	ClearInFlight(Key);
+}
+
+void USwarmPathSchedulerSubsystem::DrainCompletions(double Now)
+{
+	FCompletion C;
+	while (Completions.Dequeue(C))
+	{
+		--InFlight;
+
+		FAsyncSolve& S = *C.Solve;
+		if (C.bSuccess)
+		{
+			switch (S.Kind)
+			{
+			case ESolveKind::Repair: ++Current.Repairs; break;
+			case ESolveKind::Join:   ++Current.Joins;   break;
+			case ESolveKind::Routed: ++Current.Routed;  break;
+			default: break;
+			}
+
+			if (bFunnelCorridors && S.Kind == ESolveKind::Full && !S.LastPath->IsPartial())
+			{
+				if (const FNavMeshPath* MeshPath = S.LastPath->CastPath<FNavMeshPath>())
+				{
+					CacheSS->GetCorridors().Add(S.Request.Key, MeshPath->PathCorridor, MeshPath->GetPathCorridorEdges(),
+						S.Points[0], S.Points.Last(), Now);
+				}
+			}
+		}
+
+		Scratch = MoveTemp(S.Points);
+		Finish(S.Request.Key, Now, S.Kind == ESolveKind::Join ? S.JoinLegSegments : MAX_int32, C.bSuccess);
+	}
+}
+
+void USwarmPathSchedulerSubsystem::Dispatch()
+{
+	if (!CacheSS)
+		return;
+
+	const double Now    = FPlatformTime::Seconds();
+	const uint64 Start  = FPlatformTime::Cycles64();
+	const double Budget = double(FMath::Max(0, BudgetMicros));
+
+	DrainCompletions(Now);
+
+	{
+		FQueued Q;
+		while (Mailbox.Dequeue(Q))
+			Queue.Add(MoveTemp(Q));
+	}
+
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+
+	int32 Next = 0;
+	if (!NavData)
+	{
+		// Nothing can be solved; hand the claims back now rather than waiting out SolveTimeout.
+		for (const FQueued& Q : Queue)
+		{
+			CacheSS->ReleaseSolve(Q.Request.Key);
+			ClearInFlight(Q.Request.Key);
+		}
+		Current.Dropped += Queue.Num();
+		Next = Queue.Num();
+	}
+	else
+	{
+		for (FQueued& Q : Queue)
+		{
+			Q.Effective = Q.Request.Priority + AgingPerSecond * float(Now - Q.EnqueueTime);
+		}
+		Queue.Sort([](const FQueued& A, const FQueued& B) { return A.Effective > B.Effective; });
+
+		const FSwarmPathPool& Pool = CacheSS->GetPool();
+		const FSwarmPathTree& Tree = CacheSS->GetGoalTree();
+
+		for (; Next < Queue.Num(); ++Next)
+		{
+			if (InFlight >= MaxInFlight || FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0 >= Budget)
+				break;
+
+			const FSwarmPathRequest& R = Queue[Next].Request;
+			if (Now - Queue[Next].EnqueueTime > MaxQueueSeconds)
+			{
+				CacheSS->ReleaseSolve(R.Key);
+				ClearInFlight(R.Key);
+				++Current.Dropped;
+				continue;
+			}
+
+			// Reused paths finish inline; everything else becomes an async search.
+			Scratch.Reset();
+			int32 JoinLegSegments = 0;
+			const TSharedRef<FAsyncSolve> Solve = MakeShared<FAsyncSolve>();
+			Solve->Request = R;
+
+			const bool bTreeGoal = bJoinPathTree && Tree.HasGoal() && Tree.GetGoalCell() == R.Key.Goal;
+			const FSwarmPathView Prev = bRepairPaths ? Pool.Resolve(R.RepairFrom) : FSwarmPathView();
+
+			const TConstArrayView<FVector3f> Warm = CacheSS->FindWarm(R.Key);
+			if (Warm.Num() >= 2)
+			{
+				for (const FVector3f& P : Warm)
+					Scratch.Add(FVector(P));
+				++Current.WarmHits;
+				Finish(R.Key, Now, MAX_int32, true);
+				continue;
+			}
+			if (bFunnelCorridors && SolveFunnel(NavSys, NavData, R, Now, Scratch))
+			{
+				++Current.Funnels;
+				Finish(R.Key, Now, MAX_int32, true);
+				continue;
+			}
+			Scratch.Reset();
+			if (bTreeGoal && SolveJoin(NavSys, NavData, R, Now, Scratch, JoinLegSegments, *Solve))
+			{
+				++Current.Joins;
+				Finish(R.Key, Now, JoinLegSegments, true);
+				continue;
+			}
+
+			if (Solve->Legs.Num() == 0
+				&& !(Prev && PlanRepair(R, Prev, *Solve))
+				&& !(R.bHierarchical && PlanRouted(NavSys, NavData, R, *Solve)))
+			{
+				PlanFull(NavSys, NavData, R, *Solve);
+			}
+
+			++InFlight;
+			IssueLeg(Solve);
+		}
+	}
+
+	const int32 Taken = Next;
+	Queue.RemoveAt(0, Taken, EAllowShrinking::No);
+	NumPending.fetch_sub(Taken, std::memory_order_relaxed);
+
+	Current.Submitted = NumSubmitted.exchange(0, std::memory_order_relaxed);
+	Current.Deduped   = NumDeduped.exchange(0, std::memory_order_relaxed);
+	Current.Dropped  += NumRejected.exchange(0, std::memory_order_relaxed);
+	Current.Evictions = NumEvicted.exchange(0, std::memory_order_relaxed);
+	Current.Micros    = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0;
+	Current.Queued    = Queue.Num();
+	Current.InFlight  = InFlight;
+
+	LastFrame = Current;
+	Current   = FFrameStats();
+}
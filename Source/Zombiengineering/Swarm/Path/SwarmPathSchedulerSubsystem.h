@@ -0,0 +1,201 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Containers/Queue.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Swarm/Path/SwarmPathCache.h"
+
+#include <atomic>
+#include "SwarmPathSchedulerSubsystem.generated.h"
+
+class USwarmPathCacheSubsystem;
+class USwarmRouteTableSubsystem;
+class UNavigationSystemV1;
+class ANavigationData;
+struct FNavAgentProperties;
+
+struct FSwarmPathRequest
+{
+	FSwarmPathKey Key;
+	FVector Start    = FVector::ZeroVector;
+	FVector Goal     = FVector::ZeroVector;
+	float   Priority = 0.f;
+	bool    bHierarchical = false;
+
+	// Previous path to the neighbouring goal cell. When set, the scheduler keeps its prefix
+	// and only solves from a splice point near the old goal to the new one.
+	FSwarmPathHandle RepairFrom;
+};
+
+namespace SwarmPath
+{
+	// Higher is solved first: close agents, stale paths, lost sight and stuck agents.
+	FORCEINLINE float RequestPriority(float DistToGoal, float Staleness, bool bLostLOS, bool bStuck)
+	{
+		const float Near  = 1.f - FMath::Clamp(DistToGoal / 8000.f, 0.f, 1.f);
+		const float Stale = FMath::Clamp(Staleness / 5.f, 0.f, 1.f);
+		return 2.f * Near + Stale + (bLostLOS ? 1.5f : 0.f) + (bStuck ? 2.f : 0.f);
+	}
+}
+
+// Single entry point for swarm path solves. Requests from any processor are claimed in an
+// in-flight bitset and against the path cache, then posted to a lock-free mailbox. After the
+// actor tick the game thread drains the mailbox, orders everything queued by priority and
+// works down it until the microsecond budget is spent: reused paths (warm store, corridor
+// funnel, raycast join) finish inline, anything that needs a navmesh search goes out through
+// FindPathAsync, up to MaxInFlight at a time. Results land in the path cache; leftovers age
+// and carry over to the next frame.
+UCLASS()
+class USwarmPathSchedulerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	struct FFrameStats
+	{
+		int32  Submitted = 0;
+		int32  Deduped   = 0;
+		int32  Dropped   = 0;
+		int32  Solves    = 0;
+		int32  Failures  = 0;
+		int32  Repairs   = 0;
+		int32  Joins     = 0;
+		int32  Routed    = 0;
+		int32  WarmHits  = 0;
+		int32  Funnels   = 0;
+		int32  Queued    = 0;
+		int32  InFlight  = 0;
+		int32  Evictions = 0;
+		double Micros    = 0.0;
+	};
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Lock-free, safe from parallel chunks. Returns how many requests were accepted; the rest
+	// were already queued, in flight or cooling down in the cache. OutAccepted, when given,
+	// has one entry per request.
+	int32 SubmitBatch(TConstArrayView<FSwarmPathRequest> Batch, double Now, int32* OutEvictions = nullptr,
+		TArrayView<bool> OutAccepted = TArrayView<bool>());
+
+	// Game thread only.
+	FORCEINLINE const FFrameStats& GetLastFrameStats() const { return LastFrame; }
+
+public:
+	UPROPERTY() int32  BudgetMicros    = 1500;
+	UPROPERTY() int32  MaxQueued       = 4096;
+	UPROPERTY() int32  MaxInFlight     = 64;
+	UPROPERTY() float  AgingPerSecond  = 2.f;
+	UPROPERTY() double MaxQueueSeconds = 2.0;
+
+	UPROPERTY() bool   bRepairPaths    = true;
+	// How far back from the old goal, along the old path, the splice point sits.
+	UPROPERTY() float  RepairBackoff   = 1000.f;
+
+	// String-pull through a neighbouring cell's corridor when the requester stands inside it.
+	UPROPERTY() bool   bFunnelCorridors = true;
+
+	// Connect to a recent path toward the same goal instead of solving the whole way.
+	UPROPERTY() bool   bJoinPathTree   = true;
+	UPROPERTY() float  JoinRadius      = 1500.f;
+
+private:
+	enum class ESolveKind : uint8 { Full, Repair, Join, Routed };
+
+	struct FQueued
+	{
+		FSwarmPathRequest Request;
+		double EnqueueTime = 0.0;
+		float  Effective   = 0.f;
+	};
+
+	// One navmesh search of an async solve. After is appended once the leg lands.
+	struct FLeg
+	{
+		FVector From = FVector::ZeroVector;
+		FVector To   = FVector::ZeroVector;
+		bool    bHierarchical = false;
+		bool    bAllowPartial = false;
+		bool    bSkipFirst    = false;
+		float   MaxLength     = 0.f;   // 0 = unbounded
+		TArray<FVector> After;
+	};
+
+	// A request waiting on FindPathAsync. Legs are searched one after another; a failed leg
+	// of a reuse method falls back to a full solve.
+	struct FAsyncSolve
+	{
+		FSwarmPathRequest Request;
+		ESolveKind Kind = ESolveKind::Full;
+		int32 JoinLegSegments = 0;
+		int32 Leg = 0;
+		TArray<FVector> Points;
+		TArray<FLeg, TInlineAllocator<2>> Legs;
+		FNavPathSharedPtr LastPath;
+	};
+
+	// Every claimed in-flight bit gets exactly one completion, with or without a path.
+	struct FCompletion
+	{
+		TSharedPtr<FAsyncSolve> Solve;
+		bool bSuccess = false;
+	};
+
+	static constexpr int32 InFlightWords = 64;
+
+	FORCEINLINE static void InFlightBit(const FSwarmPathKey& Key, uint32& OutWord, uint64& OutMask)
+	{
+		const uint32 Bit = ((GetTypeHash(Key) * 0x9E3779B1u) >> 20) & (InFlightWords * 64 - 1);
+		OutWord = Bit >> 6;
+		OutMask = 1ull << (Bit & 63);
+	}
+
+	bool TryClaimInFlight(const FSwarmPathKey& Key);
+	void ClearInFlight(const FSwarmPathKey& Key);
+
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void Dispatch();
+	void DrainCompletions(double Now);
+	// Publishes Scratch for Key (or releases the claim) and clears its in-flight bit.
+	void Finish(const FSwarmPathKey& Key, double Now, int32 TreeSegments, bool bSuccess);
+
+	void IssueLeg(const TSharedRef<FAsyncSolve>& Solve);
+	void OnLegDone(const TSharedRef<FAsyncSolve>& Solve, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	void Restart(const TSharedRef<FAsyncSolve>& Solve);
+
+	bool SolveFunnel(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+		const FSwarmPathRequest& R, double Now, TArray<FVector>& OutPoints) const;
+	bool SolveJoin(UNavigationSystemV1* NavSys, const ANavigationData* NavData,
+		const FSwarmPathRequest& R, double Now, TArray<FVector>& OutPoints, int32& OutLegSegments, FAsyncSolve& OutAsync) const;
+	bool PlanRouted(UNavigationSystemV1* NavSys, const ANavigationData* NavData, const FSwarmPathRequest& R, FAsyncSolve& OutAsync) const;
+	bool PlanRepair(const FSwarmPathRequest& R, const FSwarmPathView& Prev, FAsyncSolve& OutAsync) const;
+	void PlanFull(UNavigationSystemV1* NavSys, const ANavigationData* NavData, const FSwarmPathRequest& R, FAsyncSolve& OutAsync) const;
+
+	UPROPERTY(Transient) TObjectPtr<USwarmPathCacheSubsystem> CacheSS;
+	UPROPERTY(Transient) TObjectPtr<USwarmRouteTableSubsystem> RoutesSS;
+
+	// Producers are processor chunks; Dispatch is the only consumer.
+	TQueue<FQueued, EQueueMode::Mpsc> Mailbox;
+	// Producers are the nav callbacks; drained at the top of Dispatch.
+	TQueue<FCompletion, EQueueMode::Mpsc> Completions;
+	// Keys hash to a bit; keys sharing a bit simply wait for each other.
+	std::atomic<uint64> InFlightKeys[InFlightWords];
+	// Mailbox plus Queue, for the MaxQueued cap.
+	std::atomic<int32> NumPending{ 0 };
+
+	std::atomic<int32> NumSubmitted{ 0 };
+	std::atomic<int32> NumDeduped{ 0 };
+	std::atomic<int32> NumRejected{ 0 };
+	std::atomic<int32> NumEvicted{ 0 };
+
+	// Game thread only.
+	TArray<FQueued> Queue;
+	TArray<FVector> Scratch;
+	int32 InFlight = 0;
+
+	FFrameStats Current;
+	FFrameStats LastFrame;
+
+	FDelegateHandle PostActorTickHandle;
+};
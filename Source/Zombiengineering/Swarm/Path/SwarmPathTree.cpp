@@ -0,0 +1,100 @@
+#include "SwarmPathTree.h"
+
+void FSwarmPathTree::Reset(const FIntVector& InGoalCell)
+{
+	GoalCell = InGoalCell;
+	bHasGoal = true;
+	Nodes.Reset();
+	Cells.Reset();
+}
+
+void FSwarmPathTree::AddPath(FSwarmPathHandle Handle, const FSwarmPathView& View, double Now, int32 MaxSegments)
+{
+	if (!View || View.Num() < 2)
+		return;
+
+	// Cheaper to start over than to age out individual nodes; the next few solves refill it.
+	if (Nodes.Num() >= MaxNodes)
+	{
+		Nodes.Reset();
+		Cells.Reset();
+	}
+
+	const int32 NumSegs = View.Num() - 1;
+
+	float Remaining = 0.f;
+	TArray<float, TInlineAllocator<64>> SegRemaining;
+	SegRemaining.SetNumUninitialized(NumSegs);
+	for (int32 s = NumSegs - 1; s >= 0; --s)
+	{
+		Remaining += FVector::Dist(View[s], View[s + 1]);
+		SegRemaining[s] = Remaining;
+	}
+
+	const float Spacing = FMath::Max(50.f, NodeSpacing);
+	for (int32 s = 0; s < FMath::Min(NumSegs, MaxSegments); ++s)
+	{
+		const FVector A = View[s];
+		const FVector B = View[s + 1];
+		const float   Len = FVector::Dist(A, B);
+		const int32   Steps = FMath::Max(1, FMath::CeilToInt(Len / Spacing));
+
+		for (int32 k = 0; k < Steps && Nodes.Num() < MaxNodes; ++k)
+		{
+			const float   t   = float(k) / Steps;
+			const FVector Pos = FMath::Lerp(A, B, t);
+
+			const int32 NodeIdx = Nodes.Add({ Pos, Handle, s, SegRemaining[s] - t * Len, Now });
+			Cells.FindOrAdd(CellOf(Pos)).Add(NodeIdx);
+		}
+	}
+}
+
+void FSwarmPathTree::FindJoins(const FVector& From, float Radius, const FSwarmPathPool& Pool, double Now,
+	TArray<FJoin, TInlineAllocator<MaxJoins>>& OutJoins) const
+{
+	OutJoins.Reset();
+	if (Nodes.Num() == 0)
+		return;
+
+	const float     RadiusSq = Radius * Radius;
+	const FIntPoint Lo = CellOf(From - FVector(Radius));
+	const FIntPoint Hi = CellOf(From + FVector(Radius));
+
+	for (int32 y = Lo.Y; y <= Hi.Y; ++y)
+	{
+		for (int32 x = Lo.X; x <= Hi.X; ++x)
+		{
+			const TArray<int32>* Bucket = Cells.Find(FIntPoint(x, y));
+			if (!Bucket)
+				continue;
+
+			for (const int32 NodeIdx : *Bucket)
+			{
+				const FNode& N = Nodes[NodeIdx];
+				if (Now - N.Time > MaxAge)
+					continue;
+
+				const float DistSq = FVector::DistSquared(From, N.Pos);
+				if (DistSq > RadiusSq)
+					continue;
+
+				const float Score = FMath::Sqrt(DistSq) + N.Remaining;
+				if (OutJoins.Num() == MaxJoins && Score >= OutJoins.Last().Score)
+					continue;
+
+				const FSwarmPathView View = Pool.Resolve(N.Handle);
+				if (!View || N.Segment + 1 >= View.Num())
+					continue;
+
+				if (OutJoins.Num() == MaxJoins)
+					OutJoins.Pop(EAllowShrinking::No);
+
+				int32 At = OutJoins.Num();
+				while (At > 0 && OutJoins[At - 1].Score > Score)
+					--At;
+				OutJoins.Insert({ View, N.Pos, N.Segment, Score }, At);
+			}
+		}
+	}
+}
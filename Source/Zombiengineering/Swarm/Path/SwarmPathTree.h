@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Swarm/Path/SwarmPathPool.h"
+
+// Reverse tree of recent paths toward one goal cell. Every path solved to that goal is
+// sampled into nodes that remember where on the path they sit and how far the goal still is,
+// so a new requester can connect to the nearest node and reuse the rest of that path.
+// Nodes reference pooled paths without owning them; a node whose path has been reclaimed
+// simply stops resolving.
+class FSwarmPathTree
+{
+public:
+	struct FJoin
+	{
+		FSwarmPathView View;
+		FVector Pos = FVector::ZeroVector;
+		int32   Segment   = 0;     // Pos lies on View[Segment] -> View[Segment + 1]
+		float   Score     = 0.f;   // distance to Pos plus remaining path length
+	};
+
+	static constexpr int32 MaxJoins = 4;
+
+	void Reset(const FIntVector& InGoalCell);
+
+	FORCEINLINE const FIntVector& GetGoalCell() const { return GoalCell; }
+	FORCEINLINE bool  HasGoal() const { return bHasGoal; }
+	FORCEINLINE int32 Num()     const { return Nodes.Num(); }
+
+	// Samples segments [0, MaxSegments) of the path every NodeSpacing units.
+	void AddPath(FSwarmPathHandle Handle, const FSwarmPathView& View, double Now, int32 MaxSegments = MAX_int32);
+
+	// Best join candidates within Radius of From, ordered by Score.
+	void FindJoins(const FVector& From, float Radius, const FSwarmPathPool& Pool, double Now,
+		TArray<FJoin, TInlineAllocator<MaxJoins>>& OutJoins) const;
+
+public:
+	float  NodeSpacing = 400.f;
+	float  CellSize    = 500.f;
+	double MaxAge      = 5.0;
+	int32  MaxNodes    = 32768;
+
+private:
+	struct FNode
+	{
+		FVector Pos;
+		FSwarmPathHandle Handle;
+		int32  Segment;
+		float  Remaining;
+		double Time;
+	};
+
+	FORCEINLINE FIntPoint CellOf(const FVector& P) const
+	{
+		return FIntPoint(FMath::FloorToInt(P.X / CellSize), FMath::FloorToInt(P.Y / CellSize));
+	}
+
+	FIntVector GoalCell = FIntVector::ZeroValue;
+	bool bHasGoal = false;
+
+	TArray<FNode> Nodes;
+	TMap<FIntPoint, TArray<int32>> Cells;
+};
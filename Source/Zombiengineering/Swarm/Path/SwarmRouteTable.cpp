@@ -0,0 +1,321 @@
+#include "SwarmRouteTable.h"
+
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Swarm/Path/SwarmNavVersion.h"
+
+namespace
+{
+	template <typename T>
+	FORCEINLINE void AppendPod(TArray<uint8>& Out, const T* Data, int32 Count)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(Data), int64(sizeof(T)) * Count);
+	}
+
+	FORCEINLINE int64 SectionBytes(const FSwarmRouteHeader& H)
+	{
+		return sizeof(FSwarmRouteHeader)
+			+ int64(sizeof(int32))           * H.DimX * H.DimY
+			+ int64(sizeof(FVector3f))       * H.NumRegions
+			+ int64(sizeof(int32))           * (H.NumRegions + 1)
+			+ int64(sizeof(FSwarmRouteEdge)) * H.NumEdges
+			+ int64(sizeof(FVector3f))       * H.NumEdgePoints
+			+ int64(sizeof(uint16))          * H.NumRegions * H.NumRegions;
+	}
+}
+
+bool FSwarmRouteTable::Load(const FString& Path, uint32 ExpectedSignature)
+{
+	Unload();
+
+	if (File.Open(Path) && Bind(File.GetData(), File.GetSize(), ExpectedSignature))
+		return true;
+
+	File.Close();
+	return false;
+}
+
+void FSwarmRouteTable::Unload()
+{
+	Header = nullptr;
+	CellRegion = nullptr;
+	Anchors = nullptr;
+	EdgeStart = nullptr;
+	Edges = nullptr;
+	EdgePoints = nullptr;
+	Hops = nullptr;
+
+	File.Close();
+}
+
+bool FSwarmRouteTable::Bind(const uint8* Data, int64 Size, uint32 ExpectedSignature)
+{
+	if (!Data || Size < int64(sizeof(FSwarmRouteHeader)))
+		return false;
+
+	const FSwarmRouteHeader* H = reinterpret_cast<const FSwarmRouteHeader*>(Data);
+	if (H->Magic != SwarmRoute::Magic || H->Version != SwarmRoute::Version || H->NavSignature != ExpectedSignature)
+		return false;
+	if (H->NumRegions <= 0 || H->NumRegions > SwarmRoute::MaxRegions || H->DimX <= 0 || H->DimY <= 0 ||
+		H->NumEdges < 0 || H->NumEdgePoints < 0 || !(H->RegionSize > 0.f) || SectionBytes(*H) != Size)
+		return false;
+
+	const uint8* P = Data + sizeof(FSwarmRouteHeader);
+	const int32*           InCellRegion = reinterpret_cast<const int32*>(P);           P += int64(sizeof(int32)) * H->DimX * H->DimY;
+	const FVector3f*       InAnchors    = reinterpret_cast<const FVector3f*>(P);       P += sizeof(FVector3f) * H->NumRegions;
+	const int32*           InEdgeStart  = reinterpret_cast<const int32*>(P);           P += sizeof(int32) * (H->NumRegions + 1);
+	const FSwarmRouteEdge* InEdges      = reinterpret_cast<const FSwarmRouteEdge*>(P); P += sizeof(FSwarmRouteEdge) * H->NumEdges;
+	const FVector3f*       InEdgePoints = reinterpret_cast<const FVector3f*>(P);       P += sizeof(FVector3f) * H->NumEdgePoints;
+	const uint16*          InHops       = reinterpret_cast<const uint16*>(P);
+
+	// Lookups index straight into these sections, so a truncated or hand-edited file must
+	// not get past here.
+	const int64 NumCells = int64(H->DimX) * H->DimY;
+	for (int64 c = 0; c < NumCells; ++c)
+	{
+		if (InCellRegion[c] < INDEX_NONE || InCellRegion[c] >= H->NumRegions)
+			return false;
+	}
+
+	if (InEdgeStart[0] != 0 || InEdgeStart[H->NumRegions] != H->NumEdges)
+		return false;
+	for (int32 r = 0; r < H->NumRegions; ++r)
+	{
+		if (InEdgeStart[r] > InEdgeStart[r + 1])
+			return false;
+	}
+
+	for (int32 e = 0; e < H->NumEdges; ++e)
+	{
+		const FSwarmRouteEdge& Edge = InEdges[e];
+		if (Edge.To < 0 || Edge.To >= H->NumRegions || Edge.FirstPoint < 0 || Edge.NumPoints < 0 ||
+			int64(Edge.FirstPoint) + Edge.NumPoints > H->NumEdgePoints)
+			return false;
+	}
+
+	const int64 NumHops = int64(H->NumRegions) * H->NumRegions;
+	for (int64 h = 0; h < NumHops; ++h)
+	{
+		if (InHops[h] != SwarmRoute::NoHop && InHops[h] >= H->NumRegions)
+			return false;
+	}
+
+	CellRegion = InCellRegion;
+	Anchors    = InAnchors;
+	EdgeStart  = InEdgeStart;
+	Edges      = InEdges;
+	EdgePoints = InEdgePoints;
+	Hops       = InHops;
+	Header     = H;
+	return true;
+}
+
+int32 FSwarmRouteTable::RegionAt(const FVector& P) const
+{
+	if (!Header)
+		return INDEX_NONE;
+
+	const int32 X = FMath::FloorToInt((float(P.X) - Header->Origin.X) / Header->RegionSize);
+	const int32 Y = FMath::FloorToInt((float(P.Y) - Header->Origin.Y) / Header->RegionSize);
+	if (X < 0 || Y < 0 || X >= Header->DimX || Y >= Header->DimY)
+		return INDEX_NONE;
+
+	return CellRegion[Y * Header->DimX + X];
+}
+
+int32 FSwarmRouteTable::NextHop(int32 From, int32 To) const
+{
+	if (!Header || From < 0 || To < 0 || From >= Header->NumRegions || To >= Header->NumRegions)
+		return INDEX_NONE;
+
+	const uint16 Hop = Hops[int64(From) * Header->NumRegions + To];
+	return Hop == SwarmRoute::NoHop ? INDEX_NONE : int32(Hop);
+}
+
+FVector FSwarmRouteTable::GetAnchor(int32 Region) const
+{
+	return FVector(Anchors[Region]);
+}
+
+TConstArrayView<FVector3f> FSwarmRouteTable::GetEdgePath(int32 From, int32 To) const
+{
+	for (int32 e = EdgeStart[From]; e < EdgeStart[From + 1]; ++e)
+	{
+		if (Edges[e].To == To)
+			return TConstArrayView<FVector3f>(EdgePoints + Edges[e].FirstPoint, Edges[e].NumPoints);
+	}
+	return TConstArrayView<FVector3f>();
+}
+
+uint32 FSwarmRouteTable::NavSignature(const ANavigationData* NavData)
+{
+	return SwarmNav::ComputeVersionHash(NavData);
+}
+
+bool FSwarmRouteTable::Build(UNavigationSystemV1* NavSys, const ANavigationData* NavData, float RegionSize,
+	TArray<uint8>& OutBytes, FString& OutError)
+{
+	OutBytes.Reset();
+
+	if (!NavSys || !NavData)
+	{
+		OutError = TEXT("no navigation data");
+		return false;
+	}
+
+	const FBox Bounds = NavData->GetBounds();
+	if (!Bounds.IsValid)
+	{
+		OutError = TEXT("navmesh has no bounds");
+		return false;
+	}
+
+	RegionSize = FMath::Max(500.f, RegionSize);
+	const FVector Size = Bounds.GetSize();
+	const int32 DimX = FMath::Max(1, FMath::CeilToInt(Size.X / RegionSize));
+	const int32 DimY = FMath::Max(1, FMath::CeilToInt(Size.Y / RegionSize));
+
+	// Regions: one per grid cell that has navmesh, anchored at the navmesh point nearest its centre.
+	TArray<int32>     CellRegion;
+	TArray<FIntPoint> RegionCell;
+	TArray<FVector3f> Anchors;
+	CellRegion.Init(INDEX_NONE, DimX * DimY);
+
+	const FVector Extent(RegionSize * 0.5f, RegionSize * 0.5f, Bounds.GetExtent().Z + 100.f);
+	for (int32 y = 0; y < DimY; ++y)
+	{
+		for (int32 x = 0; x < DimX; ++x)
+		{
+			const FVector Center(Bounds.Min.X + (x + 0.5f) * RegionSize, Bounds.Min.Y + (y + 0.5f) * RegionSize, Bounds.GetCenter().Z);
+			FNavLocation Loc;
+			if (!NavSys->ProjectPointToNavigation(Center, Loc, Extent, NavData))
+				continue;
+
+			if (Anchors.Num() >= SwarmRoute::MaxRegions)
+			{
+				OutError = FString::Printf(TEXT("more than %d regions; raise the region size"), SwarmRoute::MaxRegions);
+				return false;
+			}
+			CellRegion[y * DimX + x] = Anchors.Add(FVector3f(Loc.Location));
+			RegionCell.Add(FIntPoint(x, y));
+		}
+	}
+
+	const int32 R = Anchors.Num();
+	if (R == 0)
+	{
+		OutError = TEXT("no navmesh found inside the bounds");
+		return false;
+	}
+
+	// Edges: solve anchor to anchor for every neighbouring region and keep the ones that stay local.
+	const FNavDataConfig& Cfg = NavData->GetConfig();
+	FNavAgentProperties AgentProps;
+	AgentProps.AgentRadius = Cfg.AgentRadius;
+	AgentProps.AgentHeight = Cfg.AgentHeight;
+
+	TArray<int32>           EdgeStart;
+	TArray<FSwarmRouteEdge> Edges;
+	TArray<FVector3f>       EdgePoints;
+	EdgeStart.SetNumUninitialized(R + 1);
+
+	for (int32 u = 0; u < R; ++u)
+	{
+		EdgeStart[u] = Edges.Num();
+		for (int32 dy = -1; dy <= 1; ++dy)
+		{
+			for (int32 dx = -1; dx <= 1; ++dx)
+			{
+				const FIntPoint C = RegionCell[u] + FIntPoint(dx, dy);
+				if ((dx == 0 && dy == 0) || C.X < 0 || C.Y < 0 || C.X >= DimX || C.Y >= DimY)
+					continue;
+
+				const int32 v = CellRegion[C.Y * DimX + C.X];
+				if (v == INDEX_NONE)
+					continue;
+
+				const FVector A(Anchors[u]), B(Anchors[v]);
+				const FPathFindingQuery PFQ(nullptr, *NavData, A, B);
+				const FPathFindingResult Result = NavSys->FindPathSync(AgentProps, PFQ, EPathFindingMode::Regular);
+				if (!Result.IsSuccessful() || Result.IsPartial() || !Result.Path.IsValid())
+					continue;
+
+				const float Cost = Result.Path->GetLength();
+				if (Cost > 3.f * FVector::Dist(A, B))
+					continue;
+
+				const TArray<FNavPathPoint>& Pts = Result.Path->GetPathPoints();
+				Edges.Add({ v, EdgePoints.Num(), Pts.Num(), Cost });
+				for (const FNavPathPoint& Pt : Pts)
+					EdgePoints.Add(FVector3f(Pt.Location));
+			}
+		}
+	}
+	EdgeStart[R] = Edges.Num();
+
+	// Next hops: Dijkstra toward every destination over the reversed edges.
+	TArray<TArray<TPair<int32, float>>> Incoming;
+	Incoming.SetNum(R);
+	for (int32 u = 0; u < R; ++u)
+	{
+		for (int32 e = EdgeStart[u]; e < EdgeStart[u + 1]; ++e)
+			Incoming[Edges[e].To].Add({ u, Edges[e].Cost });
+	}
+
+	TArray<uint16> Hops;
+	Hops.Init(SwarmRoute::NoHop, R * R);
+
+	TArray<float> Dist;
+	TArray<TPair<float, int32>> Heap;
+	for (int32 t = 0; t < R; ++t)
+	{
+		Dist.Init(TNumericLimits<float>::Max(), R);
+		Dist[t] = 0.f;
+		Hops[t * R + t] = uint16(t);
+
+		Heap.Reset();
+		Heap.HeapPush({ 0.f, t }, TLess<>());
+		while (Heap.Num() > 0)
+		{
+			TPair<float, int32> Top;
+			Heap.HeapPop(Top, TLess<>());
+			const int32 v = Top.Value;
+			if (Top.Key > Dist[v])
+				continue;
+
+			for (const TPair<int32, float>& In : Incoming[v])
+			{
+				const int32 u = In.Key;
+				const float D = Dist[v] + In.Value;
+				if (D < Dist[u])
+				{
+					Dist[u] = D;
+					Hops[u * R + t] = uint16(v);
+					Heap.HeapPush({ D, u }, TLess<>());
+				}
+			}
+		}
+	}
+
+	FSwarmRouteHeader H;
+	H.Magic         = SwarmRoute::Magic;
+	H.Version       = SwarmRoute::Version;
+	H.NavSignature  = NavSignature(NavData);
+	H.NumRegions    = R;
+	H.NumEdges      = Edges.Num();
+	H.NumEdgePoints = EdgePoints.Num();
+	H.DimX          = DimX;
+	H.DimY          = DimY;
+	H.RegionSize    = RegionSize;
+	H.Origin        = FVector3f(Bounds.Min);
+
+	OutBytes.Reserve(SectionBytes(H));
+	AppendPod(OutBytes, &H, 1);
+	AppendPod(OutBytes, CellRegion.GetData(), CellRegion.Num());
+	AppendPod(OutBytes, Anchors.GetData(),    Anchors.Num());
+	AppendPod(OutBytes, EdgeStart.GetData(),  EdgeStart.Num());
+	AppendPod(OutBytes, Edges.GetData(),      Edges.Num());
+	AppendPod(OutBytes, EdgePoints.GetData(), EdgePoints.Num());
+	AppendPod(OutBytes, Hops.GetData(),       Hops.Num());
+	return true;
+}
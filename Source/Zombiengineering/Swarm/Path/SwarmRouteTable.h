@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Swarm/Memory/SwarmMappedFile.h"
+
+class UNavigationSystemV1;
+class ANavigationData;
+
+namespace SwarmRoute
+{
+	constexpr uint32 Magic      = 0x54525753; // "SWRT"
+	constexpr uint32 Version    = 1;
+	constexpr uint16 NoHop      = 0xFFFF;
+	constexpr int32  MaxRegions = 4096;
+}
+
+// On-disk layout, every section 4-byte aligned and read in place:
+//   FSwarmRouteHeader
+//   int32             CellRegion[DimX * DimY]      -1 where the cell has no navmesh
+//   FVector3f         Anchors[NumRegions]
+//   int32             EdgeStart[NumRegions + 1]
+//   FSwarmRouteEdge   Edges[NumEdges]              sorted by source region
+//   FVector3f         EdgePoints[NumEdgePoints]    anchor-to-anchor nav paths
+//   uint16            NextHop[NumRegions * NumRegions]
+struct FSwarmRouteHeader
+{
+	uint32    Magic;
+	uint32    Version;
+	uint32    NavSignature;
+	int32     NumRegions;
+	int32     NumEdges;
+	int32     NumEdgePoints;
+	int32     DimX;
+	int32     DimY;
+	float     RegionSize;
+	FVector3f Origin;
+};
+
+struct FSwarmRouteEdge
+{
+	int32 To;
+	int32 FirstPoint;
+	int32 NumPoints;
+	float Cost;
+};
+
+// Region-to-region routing for a static navmesh. The level is cut into square regions, each
+// with a navmesh anchor; neighbouring anchors are connected by precomputed nav paths and an
+// all-pairs next-hop table says which neighbour to take toward any destination region.
+// Built offline, then memory-mapped read-only at runtime.
+class FSwarmRouteTable
+{
+public:
+	~FSwarmRouteTable() { Unload(); }
+
+	bool Load(const FString& Path, uint32 ExpectedSignature);
+	void Unload();
+
+	FORCEINLINE bool  IsLoaded() const { return Header != nullptr; }
+	FORCEINLINE int32 Num()      const { return Header ? Header->NumRegions : 0; }
+
+	int32   RegionAt(const FVector& P) const;
+	int32   NextHop(int32 From, int32 To) const;
+	FVector GetAnchor(int32 Region) const;
+	TConstArrayView<FVector3f> GetEdgePath(int32 From, int32 To) const;
+
+	static uint32 NavSignature(const ANavigationData* NavData);
+
+	// Offline step: partitions the navmesh, solves every neighbour connection and serializes the result.
+	static bool Build(UNavigationSystemV1* NavSys, const ANavigationData* NavData, float RegionSize,
+		TArray<uint8>& OutBytes, FString& OutError);
+
+private:
+	bool Bind(const uint8* Data, int64 Size, uint32 ExpectedSignature);
+
+	FSwarmMappedFile File;
+
+	const FSwarmRouteHeader* Header     = nullptr;
+	const int32*             CellRegion = nullptr;
+	const FVector3f*         Anchors    = nullptr;
+	const int32*             EdgeStart  = nullptr;
+	const FSwarmRouteEdge*   Edges      = nullptr;
+	const FVector3f*         EdgePoints = nullptr;
+	const uint16*            Hops       = nullptr;
+};
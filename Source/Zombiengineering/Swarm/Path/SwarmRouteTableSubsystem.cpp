@@ -0,0 +1,99 @@
+#include "SwarmRouteTableSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSwarmRoute, Log, All);
+
+namespace
+{
+	const ANavigationData* GetDefaultNavData(UWorld* World, UNavigationSystemV1*& OutNavSys)
+	{
+		OutNavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+		return OutNavSys ? OutNavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	}
+}
+
+void USwarmRouteTableSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	Reload();
+}
+
+void USwarmRouteTableSubsystem::Deinitialize()
+{
+	Table.Unload();
+	Super::Deinitialize();
+}
+
+FString USwarmRouteTableSubsystem::GetTablePath() const
+{
+	const UWorld* World = GetWorld();
+	const FString MapName = World ? UWorld::RemovePIEPrefix(World->GetMapName()) : FString();
+	return FPaths::ProjectContentDir() / TEXT("Swarm/Routes") / (MapName + TEXT(".swroute"));
+}
+
+bool USwarmRouteTableSubsystem::Reload()
+{
+	UNavigationSystemV1* NavSys = nullptr;
+	const ANavigationData* NavData = GetDefaultNavData(GetWorld(), NavSys);
+
+	const FString Path = GetTablePath();
+	if (!Table.Load(Path, FSwarmRouteTable::NavSignature(NavData)))
+	{
+		if (FPaths::FileExists(Path))
+		{
+			UE_LOG(LogSwarmRoute, Warning, TEXT("Route table %s is stale or invalid; rebuild it with Swarm.BuildRouteTable"), *Path);
+		}
+		return false;
+	}
+
+	UE_LOG(LogSwarmRoute, Log, TEXT("Route table %s: %d regions"), *Path, Table.Num());
+	return true;
+}
+
+bool USwarmRouteTableSubsystem::BuildAndSave(float RegionSize, FString& OutError)
+{
+	UNavigationSystemV1* NavSys = nullptr;
+	const ANavigationData* NavData = GetDefaultNavData(GetWorld(), NavSys);
+
+	TArray<uint8> Bytes;
+	if (!FSwarmRouteTable::Build(NavSys, NavData, RegionSize > 0.f ? RegionSize : DefaultRegionSize, Bytes, OutError))
+		return false;
+
+	// The old mapping has to go before the file can be replaced.
+	Table.Unload();
+
+	const FString Path = GetTablePath();
+	if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+	{
+		OutError = FString::Printf(TEXT("could not write %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogSwarmRoute, Log, TEXT("Wrote route table %s (%d KB)"), *Path, Bytes.Num() / 1024);
+	return Reload();
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs GSwarmBuildRouteTableCmd(
+	TEXT("Swarm.BuildRouteTable"),
+	TEXT("Partitions the navmesh into regions and writes the region next-hop table for this map. Optional arg: region size."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USwarmRouteTableSubsystem* Routes = World ? World->GetSubsystem<USwarmRouteTableSubsystem>() : nullptr;
+		if (!Routes)
+			return;
+
+		const float RegionSize = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.f;
+		FString Error;
+		if (!Routes->BuildAndSave(RegionSize, Error))
+		{
+			UE_LOG(LogSwarmRoute, Error, TEXT("Swarm.BuildRouteTable failed: %s"), *Error);
+		}
+	}));
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Swarm/Path/SwarmRouteTable.h"
+#include "SwarmRouteTableSubsystem.generated.h"
+
+// Owns the precomputed route table for the current map. The table is built offline with
+// Swarm.BuildRouteTable and loaded, memory-mapped, when play begins; it is ignored when it
+// was built against a different navmesh.
+UCLASS()
+class USwarmRouteTableSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	FORCEINLINE const FSwarmRouteTable* GetTable() const { return Table.IsLoaded() ? &Table : nullptr; }
+
+	FString GetTablePath() const;
+
+	bool BuildAndSave(float RegionSize, FString& OutError);
+	bool Reload();
+
+public:
+	UPROPERTY() float DefaultRegionSize = 4000.f;
+
+private:
+	FSwarmRouteTable Table;
+};
@@ -0,0 +1,116 @@
+#include "SwarmWarmPathStore.h"
+
+namespace
+{
+	FORCEINLINE bool KeyLess(const FIntVector& AS, const FIntVector& AG, const FIntVector& BS, const FIntVector& BG)
+	{
+		if (AS.X != BS.X) return AS.X < BS.X;
+		if (AS.Y != BS.Y) return AS.Y < BS.Y;
+		if (AS.Z != BS.Z) return AS.Z < BS.Z;
+		if (AG.X != BG.X) return AG.X < BG.X;
+		if (AG.Y != BG.Y) return AG.Y < BG.Y;
+		return AG.Z < BG.Z;
+	}
+}
+
+bool FSwarmWarmPathStore::Load(const FString& Path, uint32 ExpectedNavHash)
+{
+	Unload();
+
+	if (!File.Open(Path) || File.GetSize() < int64(sizeof(FSwarmWarmPathHeader)))
+	{
+		File.Close();
+		return false;
+	}
+
+	const FSwarmWarmPathHeader* H = reinterpret_cast<const FSwarmWarmPathHeader*>(File.GetData());
+	const int64 Expected = sizeof(FSwarmWarmPathHeader)
+		+ int64(sizeof(FSwarmWarmPathEntry)) * H->NumEntries
+		+ int64(sizeof(FVector3f)) * H->NumPoints;
+
+	if (H->Magic != SwarmWarmPath::Magic || H->Version != SwarmWarmPath::Version || H->NavHash != ExpectedNavHash ||
+		H->NumEntries < 0 || H->NumPoints < 0 || Expected != File.GetSize())
+	{
+		File.Close();
+		return false;
+	}
+
+	Entries = reinterpret_cast<const FSwarmWarmPathEntry*>(File.GetData() + sizeof(FSwarmWarmPathHeader));
+	Points  = reinterpret_cast<const FVector3f*>(Entries + H->NumEntries);
+	Header  = H;
+	return true;
+}
+
+void FSwarmWarmPathStore::Unload()
+{
+	Header  = nullptr;
+	Entries = nullptr;
+	Points  = nullptr;
+	File.Close();
+}
+
+TConstArrayView<FVector3f> FSwarmWarmPathStore::Find(const FSwarmPathKey& Key) const
+{
+	if (!Header)
+		return TConstArrayView<FVector3f>();
+
+	int32 Lo = 0, Hi = Header->NumEntries;
+	while (Lo < Hi)
+	{
+		const int32 Mid = (Lo + Hi) / 2;
+		if (KeyLess(Entries[Mid].Start, Entries[Mid].Goal, Key.Start, Key.Goal))
+			Lo = Mid + 1;
+		else
+			Hi = Mid;
+	}
+
+	if (Lo < Header->NumEntries && Entries[Lo].Start == Key.Start && Entries[Lo].Goal == Key.Goal)
+	{
+		const FSwarmWarmPathEntry& E = Entries[Lo];
+		if (E.FirstPoint >= 0 && E.NumPoints >= 0 && E.FirstPoint + E.NumPoints <= Header->NumPoints)
+			return TConstArrayView<FVector3f>(Points + E.FirstPoint, E.NumPoints);
+	}
+	return TConstArrayView<FVector3f>();
+}
+
+void FSwarmWarmPathStore::Serialize(TConstArrayView<TPair<FSwarmPathKey, FSwarmPathView>> Paths, uint32 NavHash, TArray<uint8>& OutBytes)
+{
+	TArray<int32> Order;
+	Order.Reserve(Paths.Num());
+	for (int32 i = 0; i < Paths.Num(); ++i)
+	{
+		if (Paths[i].Value.Num() >= 2)
+			Order.Add(i);
+	}
+	Order.Sort([&Paths](int32 A, int32 B)
+	{
+		return KeyLess(Paths[A].Key.Start, Paths[A].Key.Goal, Paths[B].Key.Start, Paths[B].Key.Goal);
+	});
+
+	TArray<FSwarmWarmPathEntry> Entries;
+	TArray<FVector3f>           Points;
+	Entries.Reserve(Order.Num());
+	for (const int32 i : Order)
+	{
+		const FSwarmPathKey&  Key  = Paths[i].Key;
+		const FSwarmPathView& View = Paths[i].Value;
+		if (Entries.Num() > 0 && Entries.Last().Start == Key.Start && Entries.Last().Goal == Key.Goal)
+			continue;
+
+		Entries.Add({ Key.Start, Key.Goal, Points.Num(), View.Num() });
+		for (int32 k = 0; k < View.Num(); ++k)
+			Points.Add(FVector3f(View[k]));
+	}
+
+	FSwarmWarmPathHeader H;
+	H.Magic      = SwarmWarmPath::Magic;
+	H.Version    = SwarmWarmPath::Version;
+	H.NavHash    = NavHash;
+	H.NumEntries = Entries.Num();
+	H.NumPoints  = Points.Num();
+
+	OutBytes.Reset(sizeof(H) + Entries.Num() * sizeof(FSwarmWarmPathEntry) + Points.Num() * sizeof(FVector3f));
+	OutBytes.Append(reinterpret_cast<const uint8*>(&H), sizeof(H));
+	OutBytes.Append(reinterpret_cast<const uint8*>(Entries.GetData()), Entries.Num() * sizeof(FSwarmWarmPathEntry));
+	OutBytes.Append(reinterpret_cast<const uint8*>(Points.GetData()), Points.Num() * sizeof(FVector3f));
+}
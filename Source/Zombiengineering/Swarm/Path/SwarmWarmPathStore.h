@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Swarm/Memory/SwarmMappedFile.h"
+#include "Swarm/Path/SwarmPathCache.h"
+
+namespace SwarmWarmPath
+{
+	constexpr uint32 Magic   = 0x43575753; // "SWWC"
+	constexpr uint32 Version = 1;
+}
+
+// On-disk layout, read in place:
+//   FSwarmWarmPathHeader
+//   FSwarmWarmPathEntry  Entries[NumEntries]    sorted by (Start, Goal)
+//   FVector3f            Points[NumPoints]
+struct FSwarmWarmPathHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 NavHash;
+	int32  NumEntries;
+	int32  NumPoints;
+};
+
+struct FSwarmWarmPathEntry
+{
+	FIntVector Start;
+	FIntVector Goal;
+	int32 FirstPoint;
+	int32 NumPoints;
+};
+
+// Read-only snapshot of the hottest path cache entries from an earlier session, used to
+// answer first-wave requests without touching the navmesh.
+class FSwarmWarmPathStore
+{
+public:
+	bool Load(const FString& Path, uint32 ExpectedNavHash);
+	void Unload();
+
+	FORCEINLINE bool  IsLoaded() const { return Header != nullptr; }
+	FORCEINLINE int32 Num()      const { return Header ? Header->NumEntries : 0; }
+
+	TConstArrayView<FVector3f> Find(const FSwarmPathKey& Key) const;
+
+	static void Serialize(TConstArrayView<TPair<FSwarmPathKey, FSwarmPathView>> Paths, uint32 NavHash, TArray<uint8>& OutBytes);
+
+private:
+	FSwarmMappedFile File;
+
+	const FSwarmWarmPathHeader* Header  = nullptr;
+	const FSwarmWarmPathEntry*  Entries = nullptr;
+	const FVector3f*            Points  = nullptr;
+};
@@ -21,6 +21,7 @@ USwarmBuildSpatialGridProcessor::USwarmBuildSpatialGridProcessor()
 void USwarmBuildSpatialGridProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
 {
 	Query.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
 	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
 }
 
@@ -7,8 +7,14 @@
 #include "MassCommonTypes.h"
 #include "MassExecutionContext.h"
 #include "MassEntityManager.h"
+#include "Engine/World.h"
 #include "Swarm/Fragment/SwarmTypes.h"
 #include "SwarmProcessorCommons.h"
+#include "Swarm/Budget/SwarmBudgetSubsystem.h"
+#include "Swarm/Grid/SwarmGridSubsystem.h"
+#include "Swarm/LOD/SwarmLODControllerSubsystem.h"
+#include "Swarm/Memory/SwarmFrameArenaSubsystem.h"
+#include "Swarm/Path/SwarmPathSchedulerSubsystem.h"
 #include "RenderingThread.h"
 
 #include "Misc/App.h"
@@ -136,6 +142,41 @@ void USwarmCsvLogProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 	const double ExecStartS = FPlatformTime::Seconds();
 	bool bDidLog = false;
 
+	double ArenaKB = 0.0, ArenaPeakKB = 0.0, GridKB = 0.0;
+	USwarmPathSchedulerSubsystem::FFrameStats SolveStats;
+	int32 LOSDenied = 0, ReprojectsUsed = 0, ReprojectsDenied = 0;
+	double LODCostMs = 0.0;
+	int32  LODPressure = 0;
+	if (UWorld* World = Context.GetWorld())
+	{
+		if (const USwarmPathSchedulerSubsystem* Scheduler = World->GetSubsystem<USwarmPathSchedulerSubsystem>())
+		{
+			SolveStats = Scheduler->GetLastFrameStats();
+		}
+		if (const USwarmBudgetSubsystem* Budgets = World->GetSubsystem<USwarmBudgetSubsystem>())
+		{
+			LOSDenied        = Budgets->GetDenied(ESwarmBudget::LOSTrace);
+			ReprojectsUsed   = Budgets->GetUsed(ESwarmBudget::NavReproject);
+			ReprojectsDenied = Budgets->GetDenied(ESwarmBudget::NavReproject);
+		}
+		if (const USwarmLODControllerSubsystem* LOD = World->GetSubsystem<USwarmLODControllerSubsystem>())
+		{
+			LODCostMs   = LOD->GetSmoothedCostMs();
+			LODPressure = LOD->GetPressure();
+		}
+		if (const USwarmFrameArenaSubsystem* ArenaSS = World->GetSubsystem<USwarmFrameArenaSubsystem>())
+		{
+			ArenaKB     = ArenaSS->GetFrameBytesUsed() / 1024.0;
+			ArenaPeakKB = FMath::Max<double>(ArenaSS->GetHighWaterBytes() / 1024.0, ArenaKB);
+		}
+		const USwarmGridSubsystem* GridSS = World->GetSubsystem<USwarmGridSubsystem>();
+		if (GridSS && !GridSS->IsGridEmpty())
+		{
+			GridKB = GridSS->GetGrid().GetCellBytesUsed() / 1024.0;
+		}
+	}
+	MaxArenaPeakKB = FMath::Max(MaxArenaPeakKB, ArenaPeakKB);
+
 	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
 	{
 		if (bDidLog)
@@ -150,9 +191,12 @@ void USwarmCsvLogProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 
 		FSwarmProfilerSharedFragment& P = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 
+		// Solves run after the actor tick, so this is the previous frame's slice.
+		const double T_PathSolve = SolveStats.Micros / 1000.0;
+
 		const double T_Total =
 			P.T_BuildGrid + P.T_UpdatePolicy + P.T_Perception + P.T_PathReplan +
-			P.T_Flocking + P.T_PathFollow + P.T_Integrate + P.T_PlayerCache;
+			P.T_Flocking + P.T_PathFollow + P.T_Integrate + P.T_PlayerCache + P.T_FlowField + T_PathSolve + P.T_VisField + P.T_Dormancy;
 
 		double UsedPhysMB=0, PeakUsedPhysMB=0, UsedVirtMB=0, PeakUsedVirtMB=0;
 		GetMemoryStatsMB(UsedPhysMB, PeakUsedPhysMB, UsedVirtMB, PeakUsedVirtMB);
@@ -177,24 +221,63 @@ void USwarmCsvLogProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 				"T_Total,"
 				"AvgPathAge,DirectChaseCount,RepathsUsed,LOSChecksUsed,FPS,"
 				"Mem_UsedPhysMB,Mem_PeakPhysMB,Mem_UsedVirtMB,Mem_PeakVirtMB,"
-				"CPU_ProcPctNorm,CPU_IdlePctNorm,GPU_FrameMS"));
+				"CPU_ProcPctNorm,CPU_IdlePctNorm,GPU_FrameMS,"
+				"Arena_KB,Arena_PeakKB,Grid_KB,"
+				"PathCacheHits,PathCacheMisses,PathCacheEvictions,PathCacheHitRate,"
+				"T_FlowField,FlowCellsExpanded,"
+				"T_PathSolve,PathSolves,PathRepairs,PathJoins,PathRouted,PathWarmHits,PathFunnels,PathSolveFailures,PathQueued,PathDeduped,PathDropped,"
+				"LOSShared,T_VisField,LOSFieldHits,"
+				"LOSDenied,ReprojectsUsed,ReprojectsDenied,"
+				"LOSCacheHits,LOSCacheMisses,LOSCacheHitRate,"
+				"LODCostMs,LODPressure,"
+				"T_Dormancy,AgentsDormant,AgentsParked,AgentsWoken,"
+				"PathSolvesInFlight,LOSCacheWaits"));
 			P.bPrintedHeader = true;
 		}
 
 		const double AvgPathAge = (P.AvgPathAgeNum > 0) ? (P.AvgPathAgeAccum / P.AvgPathAgeNum) : 0.0;
 
+		const int32  PathCacheLookups = P.PathCacheHits + P.PathCacheMisses;
+		const double PathCacheHitRate = (PathCacheLookups > 0) ? (double(P.PathCacheHits) / PathCacheLookups) : 0.0;
+		const int32  LOSCacheLookups = P.LOSCacheHits + P.LOSCacheMisses;
+		const double LOSCacheHitRate = (LOSCacheLookups > 0) ? (double(P.LOSCacheHits) / LOSCacheLookups) : 0.0;
+
+		Accum_PathCacheHits      += P.PathCacheHits;
+		Accum_PathCacheMisses    += P.PathCacheMisses;
+		Accum_PathCacheEvictions += P.PathCacheEvictions;
+
 		UE_LOG(LogSwarmCsv, Warning, TEXT("%.3f,"
 			"%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,"
 			"%.3f,%.3f,"
 			"%.3f,%d,%d,%d,%.3f,"
 			"%.3f,%.3f,%.3f,%.3f,"
-			"%.3f,%.3f,%.3f"),
+			"%.3f,%.3f,%.3f,"
+			"%.1f,%.1f,%.1f,"
+			"%d,%d,%d,%.3f,"
+			"%.3f,%d,"
+			"%.3f,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,"
+			"%d,%.3f,%d,"
+			"%d,%d,%d,"
+			"%d,%d,%.3f,"
+			"%.3f,%d,"
+			"%.3f,%d,%d,%d,"
+			"%d,%d"),
 			Elapsed,
 			P.T_BuildGrid, P.T_UpdatePolicy, P.T_Perception, P.T_PathReplan, P.T_Flocking, P.T_PathFollow, P.T_Integrate,
 			P.T_PlayerCache, T_Total,
 			AvgPathAge, P.DirectChaseCount, P.RepathsUsed, P.LOSChecksUsed, SmoothedFPS,
 			UsedPhysMB, PeakUsedPhysMB, UsedVirtMB, PeakUsedVirtMB,
-			(double)CpuProcPctNorm, (double)CpuIdlePctNorm, RawGPUFrameMS);
+			(double)CpuProcPctNorm, (double)CpuIdlePctNorm, RawGPUFrameMS,
+			ArenaKB, ArenaPeakKB, GridKB,
+			P.PathCacheHits, P.PathCacheMisses, P.PathCacheEvictions, PathCacheHitRate,
+			P.T_FlowField, P.FlowCellsExpanded,
+			T_PathSolve, SolveStats.Solves, SolveStats.Repairs, SolveStats.Joins, SolveStats.Routed, SolveStats.WarmHits, SolveStats.Funnels, SolveStats.Failures, SolveStats.Queued, SolveStats.Deduped, SolveStats.Dropped,
+			P.LOSShared, P.T_VisField, P.LOSFieldHits,
+			LOSDenied, ReprojectsUsed, ReprojectsDenied,
+			P.LOSCacheHits, P.LOSCacheMisses, LOSCacheHitRate,
+			LODCostMs, LODPressure,
+			P.T_Dormancy, P.AgentsDormant, P.AgentsParked, P.AgentsWoken,
+			SolveStats.InFlight, P.LOSCacheWaits);
 
 		FrameCount++;
 
@@ -207,6 +290,10 @@ void USwarmCsvLogProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 		Accum_T_Integrate    += P.T_Integrate;
 
 		Accum_T_PlayerCache  += P.T_PlayerCache;
+		Accum_T_FlowField    += P.T_FlowField;
+		Accum_T_PathSolve    += T_PathSolve;
+		Accum_T_VisField     += P.T_VisField;
+		Accum_T_Dormancy     += P.T_Dormancy;
 
 		Accum_T_Total += T_Total;
 
@@ -222,6 +309,10 @@ void USwarmCsvLogProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 		UpdateMinMax(Min_T_Integrate,    Max_T_Integrate,    P.T_Integrate);
 
 		UpdateMinMax(Min_T_PlayerCache,  Max_T_PlayerCache,  P.T_PlayerCache);
+		UpdateMinMax(Min_T_FlowField,    Max_T_FlowField,    P.T_FlowField);
+		UpdateMinMax(Min_T_PathSolve,    Max_T_PathSolve,    T_PathSolve);
+		UpdateMinMax(Min_T_VisField,     Max_T_VisField,     P.T_VisField);
+		UpdateMinMax(Min_T_Dormancy,     Max_T_Dormancy,     P.T_Dormancy);
 
 		UpdateMinMax(Min_T_Total,    Max_T_Total,    T_Total);
 
@@ -257,8 +348,15 @@ void USwarmCsvLogProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 			P.T_Flocking = P.T_PathFollow = P.T_Integrate = 0.0;
 
 		P.T_PlayerCache = 0.0;
-
-		P.RepathsUsed = P.LOSChecksUsed = 0;
+		P.T_FlowField   = 0.0;
+		P.T_VisField    = 0.0;
+		P.T_Dormancy    = 0.0;
+
+		P.RepathsUsed = P.LOSChecksUsed = P.LOSShared = P.LOSFieldHits = 0;
+		P.LOSCacheHits = P.LOSCacheMisses = P.LOSCacheWaits = 0;
+		P.PathCacheHits = P.PathCacheMisses = P.PathCacheEvictions = 0;
+		P.FlowCellsExpanded = 0;
+		P.AgentsParked = P.AgentsWoken = 0;
 		P.DirectChaseCount = 0;
 		P.AvgPathAgeAccum = 0.0;
 		P.AvgPathAgeNum   = 0;
@@ -285,6 +383,10 @@ void USwarmCsvLogProcessor::BeginDestroy()
 	PrintStat(TEXT("T_Integrate"),    Accum_T_Integrate,    FrameCount, Min_T_Integrate,    Max_T_Integrate);
 
 	PrintStat(TEXT("T_PlayerCache"),  Accum_T_PlayerCache,  FrameCount, Min_T_PlayerCache,  Max_T_PlayerCache);
+	PrintStat(TEXT("T_FlowField"),    Accum_T_FlowField,    FrameCount, Min_T_FlowField,    Max_T_FlowField);
+	PrintStat(TEXT("T_PathSolve"),    Accum_T_PathSolve,    FrameCount, Min_T_PathSolve,    Max_T_PathSolve);
+	PrintStat(TEXT("T_VisField"),     Accum_T_VisField,     FrameCount, Min_T_VisField,     Max_T_VisField);
+	PrintStat(TEXT("T_Dormancy"),     Accum_T_Dormancy,     FrameCount, Min_T_Dormancy,     Max_T_Dormancy);
 
 	PrintStat(TEXT("T_Total"),    Accum_T_Total,    FrameCount, Min_T_Total,    Max_T_Total);
 
@@ -303,6 +405,13 @@ void USwarmCsvLogProcessor::BeginDestroy()
 	}
 	
 	UE_LOG(LogSwarmCsv, Warning, TEXT("Entities  : %llu"), (unsigned long long)MaxEntityCount);
+	UE_LOG(LogSwarmCsv, Warning, TEXT("Arena peak: %.1f KB"), MaxArenaPeakKB);
+
+	const uint64 PathCacheLookups = Accum_PathCacheHits + Accum_PathCacheMisses;
+	UE_LOG(LogSwarmCsv, Warning, TEXT("PathCache : hits %llu, misses %llu, evictions %llu, hit rate %.3f"),
+		(unsigned long long)Accum_PathCacheHits, (unsigned long long)Accum_PathCacheMisses,
+		(unsigned long long)Accum_PathCacheEvictions,
+		PathCacheLookups > 0 ? double(Accum_PathCacheHits) / double(PathCacheLookups) : 0.0);
 }
 
 void USwarmCsvLogProcessor::UpdateMinMax(double& MinVal, double& MaxVal, double Sample)
@@ -42,6 +42,10 @@ private:
 	double Accum_T_PathFollow   = 0.0;
 	double Accum_T_Integrate    = 0.0;
 	double Accum_T_PlayerCache  = 0.0;
+	double Accum_T_FlowField    = 0.0;
+	double Accum_T_PathSolve    = 0.0;
+	double Accum_T_VisField     = 0.0;
+	double Accum_T_Dormancy     = 0.0;
 	double Accum_T_Total        = 0.0;
 	double Accum_AvgPathAge     = 0.0;
 	double Accum_FPS            = 0.0;
@@ -55,9 +59,19 @@ private:
 	double Min_T_Integrate    = TNumericLimits<double>::Max(); double Max_T_Integrate    = 0.0;
 
 	double Min_T_PlayerCache  = TNumericLimits<double>::Max(); double Max_T_PlayerCache  = 0.0;
+	double Min_T_FlowField    = TNumericLimits<double>::Max(); double Max_T_FlowField    = 0.0;
+	double Min_T_PathSolve    = TNumericLimits<double>::Max(); double Max_T_PathSolve    = 0.0;
+	double Min_T_VisField     = TNumericLimits<double>::Max(); double Max_T_VisField     = 0.0;
+	double Min_T_Dormancy     = TNumericLimits<double>::Max(); double Max_T_Dormancy     = 0.0;
 	
 	double Min_T_Total    = TNumericLimits<double>::Max(); double Max_T_Total    = 0.0;
 
 	double Min_AvgPathAge     = TNumericLimits<double>::Max(); double Max_AvgPathAge     = 0.0;
 	double Min_FPS            = TNumericLimits<double>::Max(); double Max_FPS            = 0.0;
+
+	double MaxArenaPeakKB = 0.0;
+
+	uint64 Accum_PathCacheHits      = 0;
+	uint64 Accum_PathCacheMisses    = 0;
+	uint64 Accum_PathCacheEvictions = 0;
 };
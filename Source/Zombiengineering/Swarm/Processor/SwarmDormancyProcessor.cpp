@@ -0,0 +1,133 @@
+#include "SwarmDormancyProcessor.h"
+
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassCommandBuffer.h"
+#include "MassEntityManager.h"
+#include "SwarmUpdatePolicyProcessor.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/LOD/SwarmDormancySubsystem.h"
+
+USwarmDormancyProcessor::USwarmDormancyProcessor()
+	: ActiveQuery(*this)
+	, Query(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteInGroup = SwarmGroups::PrePass;
+	ExecutionOrder.ExecuteAfter.Add(USwarmUpdatePolicyProcessor::StaticClass()->GetFName());
+	ExecutionOrder.ExecuteBefore.Add(SwarmGroups::Sense);
+	bRequiresGameThreadExecution = true;
+
+	ExecutionFlags = (uint8)(
+		EProcessorExecutionFlags::Standalone |
+		EProcessorExecutionFlags::Server |
+		EProcessorExecutionFlags::Client);
+
+	RegisterQuery(ActiveQuery);
+	RegisterQuery(Query);
+}
+
+void USwarmDormancyProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
+{
+	ActiveQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	ActiveQuery.AddRequirement<FSwarmPathStateFragment>(EMassFragmentAccess::ReadOnly);
+	ActiveQuery.AddRequirement<FSwarmAgentFragment>(EMassFragmentAccess::ReadWrite);
+	ActiveQuery.AddRequirement<FSwarmDormancyFragment>(EMassFragmentAccess::ReadWrite);
+	ActiveQuery.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+	ActiveQuery.AddChunkRequirement<FSwarmScheduleChunkFragment>(EMassFragmentAccess::ReadWrite);
+	ActiveQuery.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
+
+	// Matches parked agents too, so wakes still run when nothing is active.
+	Query.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USwarmDormancyProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UWorld* World = Context.GetWorld();
+	if (!World) return;
+
+	USwarmDormancySubsystem* Dormancy = World->GetSubsystem<USwarmDormancySubsystem>();
+	if (!Dormancy) return;
+
+	const double T0  = FPlatformTime::Seconds();
+	const double Now = World->GetTimeSeconds();
+
+	const int32 Divisor = FMath::Max(1, Dormancy->SleepCheckDivisor);
+	const float Dt      = Context.GetDeltaTimeSeconds() * Divisor;
+	const float SleepSq = FMath::Square(Dormancy->SleepDistance);
+	const float WakeSq  = FMath::Square(Dormancy->WakeDistance);
+
+	int32 Parked = 0;
+
+	Schedule.Begin(ActiveQuery, Context, ESwarmSchedule::Dormancy, Divisor);
+	ActiveQuery.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	{
+		int32 Begin = 0, End = 0;
+		if (!Schedule.GetChunkRange(Exec, Begin, End))
+			return;
+
+		const FPlayerSharedFragment& Player = Exec.GetSharedFragment<FPlayerSharedFragment>();
+
+		auto Xforms = Exec.GetFragmentView<FTransformFragment>();
+		auto Paths  = Exec.GetFragmentView<FSwarmPathStateFragment>();
+		auto Agents = Exec.GetMutableFragmentView<FSwarmAgentFragment>();
+		auto Dorm   = Exec.GetMutableFragmentView<FSwarmDormancyFragment>();
+
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Dorm[i].AwakeTime += Dt;
+			if (Dorm[i].AwakeTime < Dormancy->MinAwakeSeconds)
+				continue;
+
+			const FVector P  = Xforms[i].GetTransform().GetLocation();
+			const float   d2 = FVector::DistSquared2D(P, Player.PlayerLocation);
+
+			const bool bPathless = !Paths[i].bHasPath && !Paths[i].bFlowGuided;
+			if (d2 <= SleepSq && !(bPathless && d2 > WakeSq))
+				continue;
+
+			// The path is kept. A timer wake can come back while the agent is still beyond
+			// SleepDistance and park it again after MinAwakeSeconds; dropping the path each time
+			// would spend every wake on a solve and never let the agent move.
+			Agents[i].Velocity = FVector::ZeroVector;
+
+			const FMassEntityHandle Entity = Exec.GetEntity(i);
+			Exec.Defer().AddTag<FSwarmDormantTag>(Entity);
+			Dormancy->Park(Entity, P, Now);
+			++Parked;
+		}
+	});
+
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
+	{
+		const FPlayerSharedFragment& Player = Exec.GetSharedFragment<FPlayerSharedFragment>();
+
+		TArray<FMassEntityHandle> Woken;
+		Dormancy->CollectWakes(EntityManager, Player.PlayerLocation, Now, Woken);
+
+		int32 NumWoken = 0;
+		for (const FMassEntityHandle& Entity : Woken)
+		{
+			if (!EntityManager.IsEntityValid(Entity))
+				continue;
+
+			if (FSwarmDormancyFragment* Dorm = EntityManager.GetFragmentDataPtr<FSwarmDormancyFragment>(Entity))
+				Dorm->AwakeTime = 0.f;
+			// Agents that parked pathless ask for one straight away; the rest resume the path they kept.
+			FSwarmPathStateFragment* Path = EntityManager.GetFragmentDataPtr<FSwarmPathStateFragment>(Entity);
+			if (Path && !Path->bHasPath && !Path->bFlowGuided)
+				Path->RepathCooldown = 0.f;
+
+			Exec.Defer().RemoveTag<FSwarmDormantTag>(Entity);
+			++NumWoken;
+		}
+
+		Prof.AgentsParked  += Parked;
+		Prof.AgentsWoken   += NumWoken;
+		Prof.AgentsDormant  = Dormancy->GetNumParked();
+		Prof.T_Dormancy    += (FPlatformTime::Seconds() - T0) * 1000.0;
+	});
+}
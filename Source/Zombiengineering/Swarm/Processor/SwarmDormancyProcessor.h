@@ -0,0 +1,22 @@
+#pragma once
+#include "MassProcessor.h"
+#include "SwarmProcessorCommons.h"
+#include "SwarmDormancyProcessor.generated.h"
+
+UCLASS()
+class USwarmDormancyProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USwarmDormancyProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>&) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery ActiveQuery;
+	FMassEntityQuery Query;
+	FSwarmRoundRobin Schedule;
+};
@@ -0,0 +1,63 @@
+#include "SwarmFlowFieldProcessor.h"
+
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "MassCommonTypes.h"
+#include "SwarmProcessorCommons.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/Path/SwarmFlowFieldSubsystem.h"
+
+USwarmFlowFieldProcessor::USwarmFlowFieldProcessor()
+	: Query(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteInGroup = SwarmGroups::PrePass;
+	ExecutionOrder.ExecuteAfter.Add(SwarmGroups::Prepare);
+	ExecutionOrder.ExecuteBefore.Add(SwarmGroups::Path);
+	ExecutionOrder.ExecuteBefore.Add(SwarmGroups::Follow);
+	bRequiresGameThreadExecution = true;
+
+	RegisterQuery(Query);
+}
+
+void USwarmFlowFieldProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
+{
+	Query.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USwarmFlowFieldProcessor::Execute(FMassEntityManager&, FMassExecutionContext& Context)
+{
+	UWorld* World = Context.GetWorld();
+	if (!World) return;
+
+	USwarmFlowFieldSubsystem* FlowSS = World->GetSubsystem<USwarmFlowFieldSubsystem>();
+	if (!FlowSS) return;
+
+	const double T0 = FPlatformTime::Seconds();
+
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
+	{
+		const FSwarmMovementParamsFragment& Params = Exec.GetSharedFragment<FSwarmMovementParamsFragment>();
+		const FPlayerSharedFragment& Player        = Exec.GetSharedFragment<FPlayerSharedFragment>();
+
+		if (!Params.bUseFlowField)
+		{
+			if (FlowSS->HasField() || FlowSS->IsSolving())
+				FlowSS->Reset();
+			return;
+		}
+
+		const bool bHaveProjectedGoal =
+			Player.bIsOnNavMesh || (FVector::DistSquared(Player.PlayerNavLocation, Player.PlayerLocation) > 1.0f);
+		if (!bHaveProjectedGoal)
+			return;
+
+		int32 Expanded = 0, Projections = 0;
+		FlowSS->Tick(Player.PlayerNavLocation, Expanded, Projections);
+
+		Prof.FlowCellsExpanded += Expanded;
+		Prof.T_FlowField       += (FPlatformTime::Seconds() - T0) * 1000.0;
+	});
+}
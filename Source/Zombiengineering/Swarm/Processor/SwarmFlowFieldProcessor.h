@@ -0,0 +1,19 @@
+#pragma once
+#include "MassProcessor.h"
+#include "SwarmFlowFieldProcessor.generated.h"
+
+UCLASS()
+class USwarmFlowFieldProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USwarmFlowFieldProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>&) override;
+	virtual void Execute(FMassEntityManager&, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery Query;
+};
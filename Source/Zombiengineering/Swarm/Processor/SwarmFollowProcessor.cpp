@@ -1,35 +1,17 @@
 #include "SwarmFollowProcessor.h"
 
 #include "HAL/PlatformTime.h"
-#include "Misc/ScopeLock.h"
 #include "Engine/World.h"
-#include "NavigationSystem.h"
-#include "NavigationPath.h"
-#include "Async/Async.h"
 #include "MassCommonFragments.h"
 #include "MassCommonTypes.h"
 #include "MassNavigationFragments.h"
 #include "SwarmProcessorCommons.h"
 #include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/Path/SwarmFlowFieldSubsystem.h"
+#include "Swarm/Path/SwarmPathCacheSubsystem.h"
+#include "Swarm/Path/SwarmPathSchedulerSubsystem.h"
 
-FORCEINLINE int64 USwarmFollowProcessor::MakeBucketKey(const FVector& P, float Cell)
-{
-	const int32 X = FMath::FloorToInt(P.X / Cell);
-	const int32 Y = FMath::FloorToInt(P.Y / Cell);
-	return (static_cast<int64>(X) << 32) ^ static_cast<int64>(Y);
-}
-int32 USwarmFollowProcessor::FindNearestPointIndex2D(const TArray<FVector>& Pts, const FVector& Pos)
-{
-	if (Pts.Num() <= 1) return 0;
-	int32 BestIdx = 1;
-	float BestDsq = TNumericLimits<float>::Max();
-	for (int32 k = 1; k < Pts.Num(); ++k)
-	{
-		const float D = FVector::DistSquared2D(Pts[k], Pos);
-		if (D < BestDsq) { BestDsq = D; BestIdx = k; }
-	}
-	return BestIdx;
-}
+#include <atomic>
 
 USwarmFollowProcessor::USwarmFollowProcessor()
 	: FollowQuery(*this)
@@ -53,10 +35,13 @@ void USwarmFollowProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager
 	FollowQuery.AddRequirement<FSwarmSeparationFragment>(EMassFragmentAccess::ReadWrite);
 	FollowQuery.AddRequirement<FSwarmPathWindowFragment>(EMassFragmentAccess::ReadWrite);
 	FollowQuery.AddRequirement<FSwarmBudgetStampFragment>(EMassFragmentAccess::ReadWrite);
-	FollowQuery.AddRequirement<FSwarmUpdatePolicyFragment>(EMassFragmentAccess::ReadOnly);
+	FollowQuery.AddRequirement<FSwarmProgressFragment>(EMassFragmentAccess::ReadOnly);
 	FollowQuery.AddRequirement<FSwarmTargetSenseFragment>(EMassFragmentAccess::ReadOnly);
 	FollowQuery.AddRequirement<FSwarmAgentFragment>(EMassFragmentAccess::ReadOnly);
 	FollowQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	FollowQuery.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+	FollowQuery.AddChunkRequirement<FSwarmScheduleChunkFragment>(EMassFragmentAccess::ReadWrite);
+	FollowQuery.AddChunkRequirement<FSwarmLODChunkFragment>(EMassFragmentAccess::ReadOnly);
 
 	FollowQuery.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
 	FollowQuery.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
@@ -68,51 +53,56 @@ void USwarmFollowProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 	UWorld* World = Context.GetWorld();
 	if (!World) return;
 
-	const uint32 FrameIdx = (uint32)(World->TimeSeconds * 60.0f);
+	USwarmPathCacheSubsystem* CacheSS = World->GetSubsystem<USwarmPathCacheSubsystem>();
+	USwarmPathSchedulerSubsystem* Scheduler = World->GetSubsystem<USwarmPathSchedulerSubsystem>();
+	if (!CacheSS || !Scheduler) return;
+	FSwarmPathPool& Pool = CacheSS->GetPool();
 
-	{
-		FScopeLock L(&PathCS);
-		if (LastResultsFrame != FrameIdx)
-		{
-			BucketResults_RT.Reset();
-			for (auto& Pair : PendingBucketResults_GT)
-				BucketResults_RT.Add(Pair.Key, MoveTemp(Pair.Value));
-			PendingBucketResults_GT.Reset();
-			LastResultsFrame = FrameIdx;
-		}
-	}
-	const TMap<int64, TArray<FVector>>& LocalBucketResults = BucketResults_RT;
 
-	{
-		FScopeLock L(&BudgetCS);
-		if (LastBudgetResetFrame != FrameIdx)
-		{
-			LastBudgetResetFrame = FrameIdx;
-			BucketsScheduledThisFrame = 0;
-		}
-	}
+	const USwarmFlowFieldSubsystem* FlowSS = World->GetSubsystem<USwarmFlowFieldSubsystem>();
+	const USwarmFlowFieldSubsystem* Flow   = (FlowSS && FlowSS->HasField()) ? FlowSS : nullptr;
 
-	FollowQuery.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	const double T0  = FPlatformTime::Seconds();
+	const double Now = T0;
+
+	std::atomic<int32> RepathsUsed{ 0 };
+	std::atomic<int32> DirectChaseCount{ 0 };
+	std::atomic<int32> PathAgeNum{ 0 };
+	std::atomic<int64> PathAgeAccumMs{ 0 };
+
+	Schedule.Begin(FollowQuery, Context, ESwarmSchedule::Follow, 2);
+	FollowQuery.ParallelForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
 	{
-		if (!ShouldProcessChunkThisFrame(Exec)) return;
+		int32 Begin = 0, End = 0;
+		if (!Schedule.GetChunkRange(Exec, Begin, End))
+			return;
+
+		const bool bFollowFrame = IsChunkStageDue(Exec, ESwarmLODStage::Follow, Schedule.GetRound());
 
 		const FSwarmMovementParamsFragment& Params = Exec.GetSharedFragment<FSwarmMovementParamsFragment>();
-		FSwarmProfilerSharedFragment& Prof         = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
+		const FPlayerSharedFragment& Player        = Exec.GetSharedFragment<FPlayerSharedFragment>();
+
+		const bool bHaveProjectedGoal =
+			Player.bIsOnNavMesh || (FVector::DistSquared(Player.PlayerNavLocation, Player.PlayerLocation) > 1.0f);
+		const FVector FinalGoal = bHaveProjectedGoal ? Player.PlayerNavLocation : Player.PlayerLocation;
+		const FIntVector GoalCell = SwarmPath::QuantizeCell(FinalGoal);
 
-		const int32 N = Exec.GetNumEntities();
-		if (N == 0) return;
+		TArray<FSwarmPathRequest, TInlineAllocator<16>> ChunkRequests;
+		TArray<int32, TInlineAllocator<16>> RequestAgents;
+
+		int32  ChunkRepaths = 0, ChunkDirect = 0, ChunkAgeNum = 0;
+		double ChunkAgeAccum = 0.0;
 
 		auto Paths       = Exec.GetMutableFragmentView<FSwarmPathStateFragment>();
 		auto Steer       = Exec.GetMutableFragmentView<FSwarmSeparationFragment>();
 		auto PathWindow  = Exec.GetMutableFragmentView<FSwarmPathWindowFragment>();
 		auto BudgetStamp = Exec.GetMutableFragmentView<FSwarmBudgetStampFragment>();
-		auto Policy      = Exec.GetFragmentView<FSwarmUpdatePolicyFragment>();
+		auto Progress    = Exec.GetFragmentView<FSwarmProgressFragment>();
 		auto Sense       = Exec.GetFragmentView<FSwarmTargetSenseFragment>();
 		auto Agents    = Exec.GetFragmentView<FSwarmAgentFragment>();
 		auto Transforms    = Exec.GetFragmentView<FTransformFragment>();
 
 		const float  Dt = FMath::Clamp(Exec.GetDeltaTimeSeconds(), 0.f, 0.05f);
-		const double T0 = FPlatformTime::Seconds();
 
 		auto IsPathFresh = [&](int i, const FVector& selfPos)
 		{
@@ -130,7 +120,7 @@ void USwarmFollowProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 				&& (Paths[i].Index < Paths[i].NumPoints());
 		};
 
-		auto AdvanceWaypointIfClose = [&](int i, const FVector& selfPos, FVector& target)
+		auto AdvanceWaypointIfClose = [&](int i, const FSwarmPathView& View, const FVector& selfPos, FVector& target)
 		{
 			if (FVector::DistSquared2D(selfPos, target) > FMath::Square(Params.WaypointAcceptanceRadius))
 				return;
@@ -140,70 +130,110 @@ void USwarmFollowProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 			Paths[i].PathAge = 0.f;
 
 			if (Paths[i].Index < Paths[i].NumPoints())
-				target = Paths[i].Point(Paths[i].Index);
+				target = View[Paths[i].Index];
 		};
 
-		auto BuildSmallWindowIfAllowed = [&](int i)
+		auto BuildSmallWindowIfAllowed = [&](int i, const FSwarmPathView& View)
 		{
-			if ((FrameIdx & Policy[i].FollowMask) != 0)
+			if (!bFollowFrame)
 				return;
 
-			const int32 num = Paths[i].NumPoints();
-			const auto clampIdx = [&](int idx) { return FMath::Clamp(idx, 0, FMath::Max(0, num - 1)); };
-
-			const int32 i0 = clampIdx(Paths[i].Index);
-			const int32 i1 = clampIdx(i0 + 1);
-			const int32 i2 = clampIdx(i1 + 1);
-
-			PathWindow[i].P0 = Paths[i].Point(i0);
-			PathWindow[i].P1 = Paths[i].Point(i1);
-			PathWindow[i].P2 = Paths[i].Point(i2);
-
-			const FVector2D v01(PathWindow[i].P1 - PathWindow[i].P0);
-			const FVector2D v12(PathWindow[i].P2 - PathWindow[i].P1);
-			const float l01Sq = v01.SquaredLength();
-			const float l12Sq = v12.SquaredLength();
+			// Tangent and curvature were computed when the path was pooled; segment i0 runs i0 -> i1.
+			const int32 last = FMath::Max(0, View.Num() - 1);
+			const int32 i0 = FMath::Clamp(Paths[i].Index, 0, last);
+			const int32 i1 = FMath::Min(i0 + 1, last);
+			const int32 i2 = FMath::Min(i1 + 1, last);
+			const FSwarmPathSegment& Seg = View.Segment(i0);
+
+			PathWindow[i].P0 = View[i0];
+			PathWindow[i].P1 = View[i1];
+			PathWindow[i].P2 = View[i2];
+			PathWindow[i].Tangent2D = FVector(Seg.Tangent2D.X, Seg.Tangent2D.Y, 0.f);
+			PathWindow[i].Curvature = Seg.Curvature;
+			PathWindow[i].bValid    = 1;
+		};
 
-			FVector2D t2d(0.f, 0.f);
-			float     curv = 0.f;
+		auto SteerTowards = [&](int i, const FVector& selfPos, const FVector& target, bool bDirect)
+		{
+			const float distToTarget = FVector::Dist2D(selfPos, target);
+			FVector pathDir = (target - selfPos).GetSafeNormal2D();
 
-			if (l01Sq > 1e-6f)
+			if (!bDirect && distToTarget > Params.PathSpreadMinDistance)
 			{
-				const float invL01 = FMath::InvSqrt(l01Sq);
-				t2d = v01 * invL01;
+				const float clamped = FMath::Min(distToTarget, Params.PathSpreadMaxDistance);
+				const float alpha   = (clamped - Params.PathSpreadMinDistance) /
+					FMath::Max(1.f, (Params.PathSpreadMaxDistance - Params.PathSpreadMinDistance));
 
-				if (l12Sq > 1e-6f)
+				const float spread = Params.PathSpreadMaxOffset * alpha * Agents[i].LaneMag * Agents[i].LaneSign;
+				if (spread != 0.f)
 				{
-					const float invL12 = FMath::InvSqrt(l12Sq);
-					const float cross  = v01.X * v12.Y - v01.Y * v12.X;
-					const float sinTh  = FMath::Abs(cross) * invL01 * invL12;
-					curv = sinTh * invL01;
+					FVector2D t2d(pathDir.X, pathDir.Y);
+					const float invLen = FMath::InvSqrt(FMath::Max(1e-4f, t2d.SquaredLength()));
+					t2d *= invLen;
+					const FVector2D right2d(-t2d.Y, t2d.X);
+					pathDir = (target + FVector(right2d.X, right2d.Y, 0.f) * spread - selfPos).GetSafeNormal2D();
 				}
 			}
 
-			PathWindow[i].Tangent2D = FVector(t2d.X, t2d.Y, 0.f);
-			PathWindow[i].Curvature = curv;
-			PathWindow[i].bValid    = 1;
+			const float dens = Steer[i].LocalDensity;
+			const float deemphasis = (dens >= 6.f) ? 0.6f : (dens >= 3.f ? 0.8f : 1.f);
+
+			Steer[i].PathDir    = pathDir;
+			Steer[i].PathWeight = Exec.GetSharedFragment<FSwarmMovementParamsFragment>().PathFollowWeight * deemphasis;
+
+			Paths[i].PathAge += Dt;
+			if (Paths[i].RepathCooldown > 0.f)
+				Paths[i].RepathCooldown = FMath::Max(0.f, Paths[i].RepathCooldown - Dt);
+
+			ChunkAgeAccum += Paths[i].PathAge;
+			ChunkAgeNum   += 1;
 		};
 
-		for (int32 i = 0; i < N; ++i)
+		for (int32 i = Begin; i < End; ++i)
 		{
 			const FVector selfPos = Transforms[i].GetTransform().GetLocation();
 
+			FVector flowTarget;
+			Paths[i].bFlowGuided = Flow && Flow->SampleSteerTarget(selfPos, flowTarget);
+			if (Paths[i].bFlowGuided)
+			{
+				const bool bClose = (FVector::DistSquared2D(selfPos, Sense[i].TargetLocation)
+					<= FMath::Square(Params.DirectChaseRange));
+				const bool bDirect = (Sense[i].bLOS && bClose);
+
+				if (bDirect)
+					++ChunkDirect;
+
+				// The field supersedes any held path; drop it so leaving the field forces a fresh solve.
+				Paths[i].ClearPath(Pool);
+				Paths[i].PathAge     = 0.f;
+				Paths[i].LastGoal    = Sense[i].TargetLocation;
+				PathWindow[i].bValid = 0;
+				SteerTowards(i, selfPos, bDirect ? Sense[i].TargetLocation : flowTarget, bDirect);
+				continue;
+			}
+
+			FSwarmPathView View = Pool.Resolve(Paths[i].PathHandle);
+			if (!View)
+				Paths[i].ClearPath(Pool);
+
 			if (Paths[i].bHasPath && Paths[i].Index >= Paths[i].NumPoints())
 				Paths[i].bHasPath = false;
 
 			bool bFresh = IsPathFresh(i, selfPos);
-			const int64 bucketKey = MakeBucketKey(selfPos, ReplanBucketCellSize);
+			const FSwarmPathKey key{ SwarmPath::QuantizeCell(selfPos), GoalCell };
 
-			if (!bFresh)
+			if (!bFresh && bHaveProjectedGoal)
 			{
-				if (const TArray<FVector>* bucketPts = LocalBucketResults.Find(bucketKey))
+				const FSwarmPathHandle cached     = CacheSS->Find(key, Now, CacheSS->TTL);
+				const FSwarmPathView   cachedView = Pool.Resolve(cached);
+				if (cachedView)
 				{
-					TSharedPtr<TArray<FVector>> shared = MakeShared<TArray<FVector>>(*bucketPts);
-					Paths[i].PointsRef = shared;
+					View = cachedView;
+					Paths[i].SetPath(Pool, cached, View.Num());
+					// Head for the end of the segment we project onto.
 					Paths[i].Index     = FMath::Clamp(
-						FindNearestPointIndex2D(*shared, selfPos), 1, FMath::Max(1, Paths[i].NumPoints() - 1));
+						SwarmPath::ProjectOntoPath2D(View, selfPos) + 1, 1, FMath::Max(1, Paths[i].NumPoints() - 1));
 					Paths[i].bHasPath  = (Paths[i].NumPoints() > 1);
 					Paths[i].PathAge   = 0.f;
 					Paths[i].LastGoal  = Sense[i].TargetLocation;
@@ -219,30 +249,28 @@ void USwarmFollowProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 					(Paths[i].Index >= Paths[i].NumPoints()) ||
 					(playerMoved2D >= ReplanPlayerMoveThreshold);
 
-				if (bShouldReplan && Paths[i].RepathCooldown <= 0.f && ((FrameIdx & Policy[i].FollowMask) == 0))
+				if (bShouldReplan && bHaveProjectedGoal && Paths[i].RepathCooldown <= 0.f && bFollowFrame)
 				{
-					const float distToGoal = FVector::Dist2D(selfPos, Sense[i].TargetLocation);
-					const bool  bUseHier   = (distToGoal > 3000.f);
-
-					if (TryRequestReplanBudgeted(Exec, Exec.GetEntity(i), selfPos, Sense[i].TargetLocation, bucketKey, bUseHier))
-					{
-						Paths[i].RepathCooldown   = 0.25f;
-						BudgetStamp[i].bDidReplan = true;
-						++Prof.RepathsUsed;
-					}
+					const float distToGoal = FVector::Dist2D(selfPos, FinalGoal);
+					const bool  bRepair    = Paths[i].bHasPath &&
+						SwarmPath::IsNeighborCell(SwarmPath::QuantizeCell(Paths[i].LastGoal), GoalCell);
+					ChunkRequests.Add({ key, selfPos, FinalGoal,
+						SwarmPath::RequestPriority(distToGoal, Paths[i].PathAge, !Sense[i].bLOS, Progress[i].bLikelyStuck),
+						distToGoal > 3000.f, bRepair ? Paths[i].PathHandle : FSwarmPathHandle() });
+					RequestAgents.Add(i);
 				}
 
 				Paths[i].PathAge += Dt;
 				if (Paths[i].RepathCooldown > 0.f)
 					Paths[i].RepathCooldown = FMath::Max(0.f, Paths[i].RepathCooldown - Dt);
 
-				Prof.AvgPathAgeAccum += Paths[i].PathAge;
-				Prof.AvgPathAgeNum   += 1;
+				ChunkAgeAccum += Paths[i].PathAge;
+				ChunkAgeNum   += 1;
 				continue;
 			}
 
-			FVector target = Paths[i].Point(Paths[i].Index);
-			AdvanceWaypointIfClose(i, selfPos, target);
+			FVector target = View[Paths[i].Index];
+			AdvanceWaypointIfClose(i, View, selfPos, target);
 
 			const bool bOnLastSegment = (Paths[i].NumPoints() <= 2) ||
 				(Paths[i].Index >= FMath::Max(1, Paths[i].NumPoints() - 2));
@@ -255,127 +283,44 @@ void USwarmFollowProcessor::Execute(FMassEntityManager&, FMassExecutionContext&
 				target = Sense[i].TargetLocation;
 				Paths[i].LastGoal    = Sense[i].TargetLocation;
 				PathWindow[i].bValid = 0;
-				++Prof.DirectChaseCount;
+				++ChunkDirect;
 			}
 			else
 			{
-				BuildSmallWindowIfAllowed(i);
+				BuildSmallWindowIfAllowed(i, View);
 			}
 
-			const float distToTarget = FVector::Dist2D(selfPos, target);
-			FVector pathDir = (target - selfPos).GetSafeNormal2D();
+			SteerTowards(i, selfPos, target, bDirect);
+		}
 
-			if (!bDirect && distToTarget > Params.PathSpreadMinDistance)
+		if (ChunkRequests.Num() > 0)
+		{
+			// Only agents whose request went in wait out the cooldown; the rest retry next frame.
+			TArray<bool, TInlineAllocator<16>> Accepted;
+			Accepted.SetNumUninitialized(ChunkRequests.Num());
+			ChunkRepaths = Scheduler->SubmitBatch(ChunkRequests, Now, nullptr, Accepted);
+			for (int32 r = 0; r < RequestAgents.Num(); ++r)
 			{
-				const float clamped = FMath::Min(distToTarget, Params.PathSpreadMaxDistance);
-				const float alpha   = (clamped - Params.PathSpreadMinDistance) /
-					FMath::Max(1.f, (Params.PathSpreadMaxDistance - Params.PathSpreadMinDistance));
-
-				const float spread = Params.PathSpreadMaxOffset * alpha * Agents[i].LaneMag * Agents[i].LaneSign;
-				if (spread != 0.f)
-				{
-					FVector2D t2d(pathDir.X, pathDir.Y);
-					const float invLen = FMath::InvSqrt(FMath::Max(1e-4f, t2d.SquaredLength()));
-					t2d *= invLen;
-					const FVector2D right2d(-t2d.Y, t2d.X);
-					pathDir = (target + FVector(right2d.X, right2d.Y, 0.f) * spread - selfPos).GetSafeNormal2D();
-				}
+				if (!Accepted[r])
+					continue;
+				const int32 i = RequestAgents[r];
+				Paths[i].RepathCooldown   = 0.25f;
+				BudgetStamp[i].bDidReplan = true;
 			}
-
-			const float dens = Steer[i].LocalDensity;
-			const float deemphasis = (dens >= 6.f) ? 0.6f : (dens >= 3.f ? 0.8f : 1.f);
-
-			Steer[i].PathDir    = pathDir;
-			Steer[i].PathWeight = Exec.GetSharedFragment<FSwarmMovementParamsFragment>().PathFollowWeight * deemphasis;
-
-			Paths[i].PathAge += Dt;
-			if (Paths[i].RepathCooldown > 0.f)
-				Paths[i].RepathCooldown = FMath::Max(0.f, Paths[i].RepathCooldown - Dt);
-
-			Prof.AvgPathAgeAccum += Paths[i].PathAge;
-			Prof.AvgPathAgeNum   += 1;
 		}
 
-		Prof.T_PathFollow += (FPlatformTime::Seconds() - T0) * 1000.0;
-	});
-}
-
-bool USwarmFollowProcessor::TryRequestReplanBudgeted(
-	FMassExecutionContext& Exec,
-	const FMassEntityHandle,
-	const FVector& From,
-	const FVector& Goal,
-	const int64 BucketKey,
-	const bool bUseHierarchical)
-{
-	{
-	FScopeLock L(&PathCS);
-	if (PendingBucketResults_GT.Contains(BucketKey) || InFlightBuckets_GT.Contains(BucketKey))
-		return true;
-	}
-	{
-	FScopeLock L(&BudgetCS);
-	if (BucketsScheduledThisFrame >= MaxBucketsPerFrame)
-		return false;
-	++BucketsScheduledThisFrame;
-	}
-
-	UWorld* World = Exec.GetWorld();
-	if (!World) return false;
+		RepathsUsed.fetch_add(ChunkRepaths, std::memory_order_relaxed);
+		DirectChaseCount.fetch_add(ChunkDirect, std::memory_order_relaxed);
+		PathAgeNum.fetch_add(ChunkAgeNum, std::memory_order_relaxed);
+		PathAgeAccumMs.fetch_add(int64(ChunkAgeAccum * 1000.0), std::memory_order_relaxed);
+	}, FMassEntityQuery::EParallelExecutionFlags::Force);
 
-	AsyncTask(ENamedThreads::GameThread, [this, World, From, Goal, BucketKey, bUseHierarchical]()
+	WithSwarmProfiler(FollowQuery, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
 	{
-		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
-		if (!NavSys) return;
-
-		const ANavigationData* NavData = NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate);
-		if (!NavData) return;
-
-		{
-			FScopeLock L(&PathCS);
-			if (InFlightBuckets_GT.Contains(BucketKey)) return;
-			InFlightBuckets_GT.Add(BucketKey);
-		}
-
-		FNavLocation FromNav, GoalNav;
-		if (!NavSys->ProjectPointToNavigation(From, FromNav, FVector(100,100,200), NavData) ||
-			!NavSys->ProjectPointToNavigation(Goal, GoalNav, FVector(100,100,200), NavData))
-		{
-			FScopeLock L(&PathCS);
-			InFlightBuckets_GT.Remove(BucketKey);
-			return;
-		}
-
-		FPathFindingQuery PFQ(nullptr, *NavData, FromNav.Location, GoalNav.Location);
-		const FNavDataConfig& cfg = NavData->GetConfig();
-		FNavAgentProperties agentProps{ };
-		agentProps.AgentRadius = cfg.AgentRadius;
-		agentProps.AgentHeight = cfg.AgentHeight;
-
-		NavSys->FindPathAsync(
-			agentProps, PFQ,
-			FNavPathQueryDelegate::CreateWeakLambda(this,
-				[this, BucketKey](uint32, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
-				{
-					TArray<FVector> pts;
-					if (Result == ENavigationQueryResult::Success && Path.IsValid())
-					{
-						const auto& P = Path->GetPathPoints();
-						if (P.Num() >= 2)
-						{
-							pts.Reserve(P.Num());
-							for (const FNavPathPoint& PP : P) pts.Add(PP.Location);
-						}
-					}
-
-					FScopeLock L(&PathCS);
-					InFlightBuckets_GT.Remove(BucketKey);
-					if (pts.Num() > 1)
-						PendingBucketResults_GT.Add(BucketKey, MoveTemp(pts));
-				}),
-			bUseHierarchical ? EPathFindingMode::Hierarchical : EPathFindingMode::Regular
-		);
+		Prof.RepathsUsed      += RepathsUsed.load();
+		Prof.DirectChaseCount += DirectChaseCount.load();
+		Prof.AvgPathAgeNum    += PathAgeNum.load();
+		Prof.AvgPathAgeAccum  += PathAgeAccumMs.load() / 1000.0;
+		Prof.T_PathFollow     += (FPlatformTime::Seconds() - T0) * 1000.0;
 	});
-
-	return true;
 }
@@ -8,6 +8,7 @@
 #include "MassNavigationFragments.h"
 #include "SwarmProcessorCommons.h"
 #include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/Budget/SwarmBudgetSubsystem.h"
 
 USwarmIntegrateProcessor::USwarmIntegrateProcessor()
 	: IntegrateQuery(*this)
@@ -36,6 +37,7 @@ void USwarmIntegrateProcessor::ConfigureQueries(const TSharedRef<FMassEntityMana
 	IntegrateQuery.AddRequirement<FSwarmTargetSenseFragment>(EMassFragmentAccess::ReadOnly);
 	IntegrateQuery.AddRequirement<FSwarmPathWindowFragment>(EMassFragmentAccess::ReadOnly);
 	IntegrateQuery.AddRequirement<FSwarmProgressFragment>(EMassFragmentAccess::ReadWrite);
+	IntegrateQuery.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
 
 	IntegrateQuery.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
 	IntegrateQuery.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
@@ -48,6 +50,7 @@ void USwarmIntegrateProcessor::Execute(FMassEntityManager&, FMassExecutionContex
 	if (!World) return;
 
 	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	USwarmBudgetSubsystem* Budgets = World->GetSubsystem<USwarmBudgetSubsystem>();
 	const uint32 FrameIdx = (uint32)(World->TimeSeconds * 60.0f);
 
 	const double T0 = FPlatformTime::Seconds();
@@ -56,7 +59,6 @@ void USwarmIntegrateProcessor::Execute(FMassEntityManager&, FMassExecutionContex
 	{
 		const FSwarmMovementParamsFragment& Params = Exec.GetSharedFragment<FSwarmMovementParamsFragment>();
 		const FPlayerSharedFragment& Player        = Exec.GetSharedFragment<FPlayerSharedFragment>();
-		FSwarmProfilerSharedFragment& Prof         = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 
 		const int32 N = Exec.GetNumEntities();
 		if (N == 0) return;
@@ -73,6 +75,8 @@ void USwarmIntegrateProcessor::Execute(FMassEntityManager&, FMassExecutionContex
 		const float  Dt = FMath::Clamp(Exec.GetDeltaTimeSeconds(), 0.f, 0.05f);
 		const double T0 = FPlatformTime::Seconds();
 
+		FSwarmBudgetLease Reprojects(Budgets, ESwarmBudget::NavReproject);
+
 		auto IsPathFresh = [&](int i, const FVector& selfPos)
 		{
 			const float speed = Params.MaxSpeed;
@@ -127,7 +131,7 @@ void USwarmIntegrateProcessor::Execute(FMassEntityManager&, FMassExecutionContex
 			}
 
 			const FVector fwd2D = T.GetRotation().GetForwardVector().GetSafeNormal2D();
-			if (!IsPathFresh(i, selfPos))
+			if (!Paths[i].bFlowGuided && !IsPathFresh(i, selfPos))
 			{
 				Freeze(i, selfPos, fwd2D);
 				continue;
@@ -282,9 +286,9 @@ void USwarmIntegrateProcessor::Execute(FMassEntityManager&, FMassExecutionContex
 			const float zSlack     = FMath::Clamp( 20.f - 0.05f * speed2DNow, 10.f, 20.f);
 
 			const bool needReproject = (distXYSq > FMath::Square(xySlack)) || (dZ > zSlack);
-			const bool haveBudget    = ((FrameIdx + (HCache++ & 0x3)) % 4) == 0;
+			const bool bOurTurn      = ((FrameIdx + uint32(Exec.GetEntity(i).Index)) & 0x3) == 0;
 
-			if (needReproject && haveBudget)
+			if (needReproject && bOurTurn && Reprojects.TryConsume())
 			{
 				FNavLocation out;
 				static const FVector Small (100.f, 100.f, 200.f);
@@ -307,12 +311,8 @@ void USwarmIntegrateProcessor::Execute(FMassEntityManager&, FMassExecutionContex
 
 	}, FMassEntityQuery::EParallelExecutionFlags::Force);
 
-	bool b = false;
-	IntegrateQuery.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	WithSwarmProfiler(IntegrateQuery, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
 	{
-		if (b) return;
-		FSwarmProfilerSharedFragment& Prof         = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 		Prof.T_Integrate = (FPlatformTime::Seconds() - T0) * 1000.0;
-		b = true;
 	});
 }
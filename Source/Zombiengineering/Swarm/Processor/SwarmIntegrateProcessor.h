@@ -16,5 +16,4 @@ protected:
 
 private:
 	FMassEntityQuery IntegrateQuery;
-	uint32 HCache = 0;
 };
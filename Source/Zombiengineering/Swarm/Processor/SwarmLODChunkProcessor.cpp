@@ -0,0 +1,48 @@
+#include "SwarmLODChunkProcessor.h"
+
+#include "Engine/World.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "SwarmProcessorCommons.h"
+#include "SwarmUpdatePolicyProcessor.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/LOD/SwarmLODControllerSubsystem.h"
+
+USwarmLODChunkProcessor::USwarmLODChunkProcessor()
+	: Query(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteInGroup = SwarmGroups::PrePass;
+	ExecutionOrder.ExecuteAfter.Add(USwarmUpdatePolicyProcessor::StaticClass()->GetFName());
+	ExecutionOrder.ExecuteBefore.Add(SwarmGroups::Sense);
+
+	RegisterQuery(Query);
+}
+
+void USwarmLODChunkProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
+{
+	Query.AddChunkRequirement<FSwarmLODChunkFragment>(EMassFragmentAccess::ReadWrite);
+	Query.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+}
+
+void USwarmLODChunkProcessor::Execute(FMassEntityManager&, FMassExecutionContext& Context)
+{
+	UWorld* World = Context.GetWorld();
+	if (!World) return;
+
+	const USwarmLODControllerSubsystem* LOD = World->GetSubsystem<USwarmLODControllerSubsystem>();
+
+	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	{
+		FSwarmLODChunkFragment& Chunk = Exec.GetMutableChunkFragment<FSwarmLODChunkFragment>();
+		if (!Chunk.bHasPhase)
+		{
+			Chunk.Phase     = NextPhase++;
+			Chunk.bHasPhase = true;
+		}
+
+		const ESwarmLODTier Tier = GetChunkLODTier(Exec);
+		for (uint8 s = 0; s < uint8(ESwarmLODStage::Num); ++s)
+			Chunk.StageMask[s] = LOD ? LOD->GetMask(ESwarmLODStage(s), Tier) : 0;
+	});
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "MassProcessor.h"
+#include "SwarmLODChunkProcessor.generated.h"
+
+// Keeps FSwarmLODChunkFragment current: hands each new chunk the next phase and copies the LOD
+// controller's rates for the chunk's tier, ahead of the stages that gate on them.
+UCLASS()
+class USwarmLODChunkProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USwarmLODChunkProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>&) override;
+	virtual void Execute(FMassEntityManager&, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery Query;
+
+	// Handed out in turn, so chunks of a tier land evenly across its frames.
+	uint8 NextPhase = 0;
+};
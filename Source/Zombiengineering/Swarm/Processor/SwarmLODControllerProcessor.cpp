@@ -0,0 +1,49 @@
+#include "SwarmLODControllerProcessor.h"
+
+#include "Engine/World.h"
+#include "MassCommonTypes.h"
+#include "SwarmProcessorCommons.h"
+#include "SwarmCsvLogProcessor.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/LOD/SwarmLODControllerSubsystem.h"
+
+USwarmLODControllerProcessor::USwarmLODControllerProcessor()
+	: Query(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteInGroup = SwarmGroups::Log;
+	// The CSV logger clears the stage timings once it has written them.
+	ExecutionOrder.ExecuteBefore.Add(USwarmCsvLogProcessor::StaticClass()->GetFName());
+	bRequiresGameThreadExecution = true;
+
+	RegisterQuery(Query);
+}
+
+void USwarmLODControllerProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
+{
+	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USwarmLODControllerProcessor::Execute(FMassEntityManager&, FMassExecutionContext& Context)
+{
+	UWorld* World = Context.GetWorld();
+	if (!World) return;
+
+	USwarmLODControllerSubsystem* LOD = World->GetSubsystem<USwarmLODControllerSubsystem>();
+	if (!LOD) return;
+
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& P)
+	{
+		FSwarmStageCosts Costs;
+		Costs.Ms[uint8(ESwarmLODStage::Sense)]      = P.T_Perception;
+		Costs.Ms[uint8(ESwarmLODStage::Follow)]     = P.T_PathFollow + P.T_PathReplan;
+		Costs.Ms[uint8(ESwarmLODStage::Separation)] = P.T_Flocking;
+
+		// Path solves run under their own microsecond budget and aren't counted here.
+		Costs.TotalMs =
+			P.T_BuildGrid + P.T_UpdatePolicy + P.T_Perception + P.T_PathReplan + P.T_Flocking +
+			P.T_PathFollow + P.T_Integrate + P.T_PlayerCache + P.T_FlowField + P.T_VisField + P.T_Dormancy;
+
+		LOD->Feed(Costs, World->GetTimeSeconds());
+	});
+}
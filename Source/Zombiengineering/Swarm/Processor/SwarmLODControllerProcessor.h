@@ -0,0 +1,19 @@
+#pragma once
+#include "MassProcessor.h"
+#include "SwarmLODControllerProcessor.generated.h"
+
+UCLASS()
+class USwarmLODControllerProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USwarmLODControllerProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>&) override;
+	virtual void Execute(FMassEntityManager&, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery Query;
+};
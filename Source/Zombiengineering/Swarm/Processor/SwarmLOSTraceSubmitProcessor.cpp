@@ -0,0 +1,64 @@
+#include "SwarmLOSTraceSubmitProcessor.h"
+
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "SwarmPerceptionProcessor.h"
+#include "SwarmProcessorCommons.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+
+USwarmLOSTraceSubmitProcessor::USwarmLOSTraceSubmitProcessor()
+	: Query(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteInGroup = SwarmGroups::Sense;
+	ExecutionOrder.ExecuteAfter.Add(USwarmPerceptionProcessor::StaticClass()->GetFName());
+	bRequiresGameThreadExecution = true;
+
+	RegisterQuery(Query);
+}
+
+void USwarmLOSTraceSubmitProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
+{
+	Query.AddRequirement<FSwarmLOSFragment>(EMassFragmentAccess::ReadWrite);
+	Query.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+	Query.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USwarmLOSTraceSubmitProcessor::Execute(FMassEntityManager&, FMassExecutionContext& Context)
+{
+	UWorld* World = Context.GetWorld();
+	if (!World) return;
+
+	const double T0 = FPlatformTime::Seconds();
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SwarmPlayerLOS), false);
+	QueryParams.bReturnPhysicalMaterial = false;
+
+	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	{
+		if (!Exec.GetSharedFragment<FSwarmMovementParamsFragment>().bAsyncLOSTraces)
+			return;
+
+		const int32 N = Exec.GetNumEntities();
+		auto LOS = Exec.GetMutableFragmentView<FSwarmLOSFragment>();
+
+		for (int32 i = 0; i < N; ++i)
+		{
+			if (!LOS[i].bTraceQueued)
+				continue;
+
+			LOS[i].bTraceQueued = false;
+			LOS[i].PendingTrace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+				FVector(LOS[i].TraceStart), FVector(LOS[i].TraceEnd), ECC_Visibility, QueryParams);
+		}
+	});
+
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
+	{
+		Prof.T_Perception += (FPlatformTime::Seconds() - T0) * 1000.0;
+	});
+}
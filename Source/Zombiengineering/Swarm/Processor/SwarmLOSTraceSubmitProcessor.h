@@ -0,0 +1,21 @@
+#pragma once
+#include "MassProcessor.h"
+#include "SwarmLOSTraceSubmitProcessor.generated.h"
+
+// Issues the async LOS traces perception queued on FSwarmLOSFragment. Async traces can only be
+// submitted from the game thread, so this is kept apart from the parallel Sense pass.
+UCLASS()
+class USwarmLOSTraceSubmitProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USwarmLOSTraceSubmitProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>&) override;
+	virtual void Execute(FMassEntityManager&, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery Query;
+};
@@ -9,6 +9,13 @@
 #include "Swarm/Fragment/SwarmTypes.h"
 #include "Swarm/Grid/AgentSpatialHashGrid.h"
 #include "Swarm/Grid/SwarmGridSubsystem.h"
+#include "Swarm/Memory/SwarmFrameArenaSubsystem.h"
+
+namespace
+{
+	// Frames per round-robin cycle; the chunk filter counts LOD frames in the same rounds.
+	constexpr uint32 ScheduleDivisor = 3;
+}
 
 USwarmLocalSeparationProcessor::USwarmLocalSeparationProcessor()
 	: Query(*this)
@@ -33,6 +40,12 @@ void USwarmLocalSeparationProcessor::ConfigureQueries(const TSharedRef<FMassEnti
 	Query.AddRequirement<FSwarmSeparationFragment>(EMassFragmentAccess::ReadWrite);
 
 	Query.AddRequirement<FSwarmUpdatePolicyFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+	Query.AddChunkRequirement<FSwarmLODChunkFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddChunkRequirement<FSwarmScheduleChunkFragment>(EMassFragmentAccess::ReadWrite);
+
+	// Off-round chunks of a decimated tier are never entered.
+	Query.SetChunkFilter(&ShouldRunSwarmChunk<ESwarmLODStage::Separation, ScheduleDivisor>);
 
 	Query.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
 	Query.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
@@ -47,44 +60,46 @@ void USwarmLocalSeparationProcessor::Execute(FMassEntityManager&, FMassExecution
 	USwarmGridSubsystem* GridSS = World->GetSubsystem<USwarmGridSubsystem>();
 	if (!GridSS) return;
 
-	const uint32 FrameIdx = static_cast<uint32>(World->TimeSeconds * 60.0f);
+	USwarmFrameArenaSubsystem* ArenaSS = World->GetSubsystem<USwarmFrameArenaSubsystem>();
+
 	constexpr float ZHalfHeight = 120.f;
 	constexpr float Skin        = 10.f;
 
 	const double T0 = FPlatformTime::Seconds();
+	Schedule.Begin(Query, Context, ESwarmSchedule::Separation, ScheduleDivisor);
 	Query.ParallelForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
 	{
-		if (!ShouldProcessChunkThisFrame(Exec, 3)) return;
+		int32 Begin = 0, End = 0;
+		if (!Schedule.GetChunkRange(Exec, Begin, End)) return;
+
+		const uint8  TierMask   = GetChunkStageMask(Exec, ESwarmLODStage::Separation);
+		const uint32 ChunkFrame = GetChunkFrame(Exec, Schedule.GetRound());
 
 		const FSwarmMovementParamsFragment& Params = Exec.GetSharedFragment<FSwarmMovementParamsFragment>();
 
 		const int32 N = Exec.GetNumEntities();
-		if (N == 0) return;
 
 		auto Xforms     = Exec.GetFragmentView<FTransformFragment>();
 		auto Separation = Exec.GetMutableFragmentView<FSwarmSeparationFragment>();
 		auto Policy     = Exec.GetFragmentView<FSwarmUpdatePolicyFragment>();
 
-		TArray<FVector, TInlineAllocator<256>> Pos;
+		FSwarmArenaScope ArenaScope(ArenaSS ? &ArenaSS->GetWorkerArena() : nullptr);
+
+		TArray<FVector, TInlineAllocator<256, FSwarmArenaAllocator>> Pos;
 		Pos.SetNumUninitialized(N);
-		for (int32 i = 0; i < N; ++i)
+		for (int32 i = Begin; i < End; ++i)
 			Pos[i] = Xforms[i].GetTransform().GetLocation();
 
 		const float QueryR      = Params.NeighborRadius;
 		const float QueryAreaM2 = FMath::Max(1e-6f, PI * (QueryR * QueryR) * 0.0001f);
-		const float Mid2 = FMath::Square(1500.f);
-		const float Far2 = FMath::Square(3000.f);
-
 		auto ShouldSkip = [&](int32 Idx) -> bool
 		{
-			const uint32 H = GetTypeHash(Exec.GetEntity(Idx));
-			const float  d2 = Policy[Idx].DistToPlayer2D_Sq;
-
-			if (d2 > Far2) { if (((FrameIdx + (H & 3u)) & 3u) != 0) return true; }
-			else if (d2 > Mid2) { if (((FrameIdx + (H & 1u)) & 1u) != 0) return true; }
-
+			// Crowding may ask for a coarser rate than the tier. Step in units of the chunk's
+			// cadence so the agent's frames stay a subset of the chunk's.
 			const uint8 Mask = Policy[Idx].SeparationMask;
-			return (Mask != 0) && (((FrameIdx + (H & Mask)) & Mask) != 0);
+			if (Mask <= TierMask) return false;
+			const uint32 H = GetTypeHash(Exec.GetEntity(Idx));
+			return ((ChunkFrame + H * (TierMask + 1u)) & Mask) != 0;
 		};
 
 		auto LocalCapFromDensity = [&](float estDensity) -> int32
@@ -94,7 +109,7 @@ void USwarmLocalSeparationProcessor::Execute(FMassEntityManager&, FMassExecution
 			return Params.MaxNeighbors;
 		};
 
-		for (int32 i = 0; i < N; ++i)
+		for (int32 i = Begin; i < End; ++i)
 		{
 			if (ShouldSkip(i)) continue;
 
@@ -156,13 +171,9 @@ void USwarmLocalSeparationProcessor::Execute(FMassEntityManager&, FMassExecution
 
 	}, FMassEntityQuery::EParallelExecutionFlags::Force);
 
-	bool b = false;
-	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
 	{
-		if (b) return;
-		FSwarmProfilerSharedFragment& Prof         = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 		Prof.T_Flocking = (FPlatformTime::Seconds() - T0) * 1000.0;
-		b = true;
 	});
 }
 
@@ -0,0 +1,41 @@
+#include "SwarmPathReleaseObserver.h"
+
+#include "Engine/World.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/Path/SwarmPathPoolSubsystem.h"
+
+USwarmPathReleaseObserver::USwarmPathReleaseObserver()
+	: Query(*this)
+{
+	ObservedType = FSwarmPathStateFragment::StaticStruct();
+	Operation    = EMassObservedOperation::Remove;
+
+	ExecutionFlags = (uint8)(
+		EProcessorExecutionFlags::Standalone |
+		EProcessorExecutionFlags::Server |
+		EProcessorExecutionFlags::Client);
+
+	RegisterQuery(Query);
+}
+
+void USwarmPathReleaseObserver::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
+{
+	Query.AddRequirement<FSwarmPathStateFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USwarmPathReleaseObserver::Execute(FMassEntityManager&, FMassExecutionContext& Context)
+{
+	UWorld* World = Context.GetWorld();
+	USwarmPathPoolSubsystem* PoolSS = World ? World->GetSubsystem<USwarmPathPoolSubsystem>() : nullptr;
+	if (!PoolSS) return;
+
+	FSwarmPathPool& Pool = PoolSS->GetPool();
+	Query.ForEachEntityChunk(Context, [&Pool](FMassExecutionContext& Exec)
+	{
+		auto Paths = Exec.GetMutableFragmentView<FSwarmPathStateFragment>();
+		for (FSwarmPathStateFragment& Path : Paths)
+			Path.ClearPath(Pool);
+	});
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "MassObserverProcessor.h"
+#include "SwarmPathReleaseObserver.generated.h"
+
+// Drops the pool reference a destroyed agent still holds on its path, so Reclaim can free the slot.
+UCLASS()
+class USwarmPathReleaseObserver : public UMassObserverProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USwarmPathReleaseObserver();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>&) override;
+	virtual void Execute(FMassEntityManager&, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery Query;
+};
@@ -5,70 +5,29 @@
 #include "HAL/PlatformTime.h"
 #include "Engine/World.h"
 #include "Algo/MinElement.h"
-#include "NavigationSystem.h"
+#include "HashTable/HashTable.h"
+#include "Swarm/Memory/SwarmFrameArenaSubsystem.h"
+#include "Swarm/Path/SwarmPathCacheSubsystem.h"
+#include "Swarm/Path/SwarmPathSchedulerSubsystem.h"
+
+#include <atomic>
 
 namespace
 {
-	struct FPathKey
+	struct FPathKeyHashTraits
 	{
-		FIntVector Start, Goal;
-		bool operator==(const FPathKey& O) const { return Start == O.Start && Goal == O.Goal; }
+		static uint32 GetKeyHash(const FSwarmPathKey& Key) { return GetTypeHash(Key); }
 	};
-	FORCEINLINE uint32 GetTypeHash(const FPathKey& K)
-	{
-		return HashCombine(GetTypeHash(K.Start), GetTypeHash(K.Goal));
-	}
 
-	struct FCachedPathEntry
-	{
-		TSharedPtr<const TArray<FVector>> Points;
-		double Time = 0.0;
-	};
-
-	TMap<FPathKey, FCachedPathEntry> GPathCache;
-	TMap<FPathKey, double>           GLastSolveTime;
+	struct FPendingEntity { int32 Index; float DistSq2D; };
 
-	constexpr float  GPathCacheCellSize   = 500.f;
-	constexpr float  GPathCacheTTL        = 0.9f;
-	constexpr double GKeySolveCooldown    = 0.20;
-	int32            GPathCacheMaxEntries = 8192;
+	using FGroupMembers = TArray<FPendingEntity, FSwarmArenaAllocator>;
+	using FGroupKV      = TestHashTable::TKeyValuePair<FSwarmPathKey, FGroupMembers>;
+	using FGroupTable   = TestHashTable::THashTable<FSwarmPathKey, FGroupKV, FPathKeyHashTraits, FSwarmArenaHashAllocator>;
 
 	FORCEINLINE FIntVector Q3D(const FVector& P)
 	{
-		return FIntVector(
-			FMath::FloorToInt(P.X / GPathCacheCellSize),
-			FMath::FloorToInt(P.Y / GPathCacheCellSize),
-			FMath::FloorToInt(P.Z / 200.f));
-	}
-
-	void GPathCache_RefreshOrInsert(const FPathKey& Key,
-		TSharedPtr<const TArray<FVector>> Points,
-		double Now)
-	{
-		FCachedPathEntry& Entry = GPathCache.FindOrAdd(Key);
-		Entry.Points = MoveTemp(Points);
-		Entry.Time   = Now;
-	}
-
-	void GPathCache_EvictOldestIfNeeded()
-	{
-		if (GPathCache.Num() <= GPathCacheMaxEntries)
-			return;
-
-		const double* MinTimePtr = nullptr;
-		FPathKey OldestKey;
-		for (const TPair<FPathKey, FCachedPathEntry>& It : GPathCache)
-		{
-			if (!MinTimePtr || It.Value.Time < *MinTimePtr)
-			{
-				MinTimePtr = &It.Value.Time;
-				OldestKey  = It.Key;
-			}
-		}
-		if (MinTimePtr)
-		{
-			GPathCache.Remove(OldestKey);
-		}
+		return SwarmPath::QuantizeCell(P);
 	}
 
 	static FORCEINLINE float ComputeCooldown(float Dist, uint32 EntityId)
@@ -116,7 +75,10 @@ void USwarmPathReplanProcessor::ConfigureQueries(const TSharedRef<FMassEntityMan
 
 	Query.AddRequirement<FSwarmTargetSenseFragment>(EMassFragmentAccess::ReadOnly);
 	Query.AddRequirement<FSwarmBudgetStampFragment>(EMassFragmentAccess::ReadWrite);
-	Query.AddRequirement<FSwarmUpdatePolicyFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddRequirement<FSwarmProgressFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+	Query.AddChunkRequirement<FSwarmScheduleChunkFragment>(EMassFragmentAccess::ReadWrite);
+	Query.AddChunkRequirement<FSwarmLODChunkFragment>(EMassFragmentAccess::ReadOnly);
 
 	Query.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
 	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
@@ -128,49 +90,52 @@ void USwarmPathReplanProcessor::Execute(FMassEntityManager&, FMassExecutionConte
 	UWorld* World = Context.GetWorld();
 	if (!World) return;
 
-	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
-	if (!NavSys) return;
+	USwarmPathCacheSubsystem* CacheSS = World->GetSubsystem<USwarmPathCacheSubsystem>();
+	USwarmPathSchedulerSubsystem* Scheduler = World->GetSubsystem<USwarmPathSchedulerSubsystem>();
+	if (!CacheSS || !Scheduler) return;
+
+	USwarmFrameArenaSubsystem* ArenaSS = World->GetSubsystem<USwarmFrameArenaSubsystem>();
+	FSwarmPathPool& Pool = CacheSS->GetPool();
 
-	const uint32 FrameIdx = (uint32)(World->TimeSeconds * 60.0f);
-	bool bRepathBudgetReset = false;
 
-	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	const double T0       = FPlatformTime::Seconds();
+	const double Now      = T0;
+
+	std::atomic<int32> RepathsUsed{ 0 };
+	std::atomic<int32> CacheHits{ 0 };
+	std::atomic<int32> CacheMisses{ 0 };
+	std::atomic<int32> CacheEvictions{ 0 };
+
+	Schedule.Begin(Query, Context, ESwarmSchedule::PathReplan, 8);
+	Query.ParallelForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
 	{
-		if (!ShouldProcessChunkThisFrame(Exec, 8))
+		int32 Begin = 0, End = 0;
+		if (!Schedule.GetChunkRange(Exec, Begin, End))
 			return;
 
+		const bool bFollowFrame = IsChunkStageDue(Exec, ESwarmLODStage::Follow, Schedule.GetRound());
+
 		const FSwarmMovementParamsFragment& Params = Exec.GetSharedFragment<FSwarmMovementParamsFragment>();
-		FSwarmProfilerSharedFragment& Prof         = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 		const FPlayerSharedFragment& Player        = Exec.GetSharedFragment<FPlayerSharedFragment>();
 
-		if (!bRepathBudgetReset)
-		{
-			Prof.RepathsUsed = 0;
-			bRepathBudgetReset = true;
-		}
-
-		const float  Dt  = Exec.GetDeltaTimeSeconds();
-		const double T0  = FPlatformTime::Seconds();
-		const double Now = T0;
+		const float Dt = Exec.GetDeltaTimeSeconds();
 
 		const bool bHaveProjectedGoal =
 			Player.bIsOnNavMesh || (FVector::DistSquared(Player.PlayerNavLocation, Player.PlayerLocation) > 1.0f);
 		const FVector    FinalGoal  = bHaveProjectedGoal ? Player.PlayerNavLocation : Player.PlayerLocation;
 		const FIntVector PlayerCell = Q3D(FinalGoal);
 
-		const int32 N = Exec.GetNumEntities();
 		auto Paths       = Exec.GetMutableFragmentView<FSwarmPathStateFragment>();
 		auto Xforms      = Exec.GetFragmentView<FTransformFragment>();
 		auto Radii       = Exec.GetFragmentView<FAgentRadiusFragment>();
 		auto Sense       = Exec.GetFragmentView<FSwarmTargetSenseFragment>();
 		auto BudgetStamp = Exec.GetMutableFragmentView<FSwarmBudgetStampFragment>();
-		auto Policy      = Exec.GetFragmentView<FSwarmUpdatePolicyFragment>();
+		auto Progress    = Exec.GetFragmentView<FSwarmProgressFragment>();
 
-		struct FPendingEntity { int32 Index; float DistSq2D; };
-		TMap<FPathKey, TArray<FPendingEntity>> Groups;
-		Groups.Reserve(FMath::Max(8, N / 8));
+		FSwarmArenaScope ArenaScope(ArenaSS ? &ArenaSS->GetWorkerArena() : nullptr);
+		FGroupTable Groups;
 
-		for (int32 i = 0; i < N; ++i)
+		for (int32 i = Begin; i < End; ++i)
 		{
 			FSwarmPathStateFragment& Path = Paths[i];
 			const FVector SelfPos = Xforms[i].GetTransform().GetTranslation();
@@ -178,7 +143,7 @@ void USwarmPathReplanProcessor::Execute(FMassEntityManager&, FMassExecutionConte
 			Path.PathAge        += Dt;
 			Path.RepathCooldown  = FMath::Max(0.f, Path.RepathCooldown - Dt);
 
-			if ((FrameIdx & Policy[i].FollowMask) != 0 || !bHaveProjectedGoal)
+			if (!bFollowFrame || !bHaveProjectedGoal || Path.bFlowGuided)
 				continue;
 
 			const bool  bOutOfPath        = !Path.bHasPath || (Path.Index >= Path.NumPoints());
@@ -198,78 +163,82 @@ void USwarmPathReplanProcessor::Execute(FMassEntityManager&, FMassExecutionConte
 
 			if (bOutOfPath || (bCooldownElapsed && bGoalMovedEnough) || bForceRepathNearEndNoLOS || bIdleStaleness)
 			{
-				const FPathKey Key{ Q3D(SelfPos), PlayerCell };
-				Groups.FindOrAdd(Key).Add({ i, DistSq2D });
+				const FSwarmPathKey Key{ Q3D(SelfPos), PlayerCell };
+				FGroupKV* Group = Groups.Find(Key);
+				if (!Group)
+				{
+					FGroupKV NewGroup;
+					NewGroup._Key = Key;
+					Group = &Groups.Insert(MoveTemp(NewGroup));
+				}
+				Group->_Value.Add({ i, DistSq2D });
 			}
 		}
 
-		if (Groups.Num() == 0 || Prof.RepathsUsed >= Params.RepathsPerFrameBudget)
-		{
-			Prof.T_PathReplan += (FPlatformTime::Seconds() - T0) * 1000.0;
+		if (Groups.Num() == 0)
 			return;
-		}
+
+		TArray<FSwarmPathRequest, TInlineAllocator<16, FSwarmArenaAllocator>> ChunkRequests;
 
 		for (auto& Pair : Groups)
 		{
-			if (Prof.RepathsUsed >= Params.RepathsPerFrameBudget)
-				break;
-
-			const FPathKey& Key = Pair.Key;
-			auto& Members = Pair.Value;
-			TSharedPtr<const TArray<FVector>> SharedRef;
+			const FSwarmPathKey& Key = Pair._Key;
+			auto& Members = Pair._Value;
 
-			if (FCachedPathEntry* Found = GPathCache.Find(Key))
+			const FSwarmPathHandle Cached = CacheSS->Find(Key, Now, CacheSS->TTL);
+			const FSwarmPathView   View   = Pool.Resolve(Cached);
+			if (!View)
 			{
-				if ((Now - Found->Time) <= GPathCacheTTL && Found->Points && Found->Points->Num() >= 2)
-				{
-					SharedRef = Found->Points;
-					Found->Time = Now;
-				}
-			}
+				CacheMisses.fetch_add(1, std::memory_order_relaxed);
 
-			if (!SharedRef)
-			{
-				if (double* LastT = GLastSolveTime.Find(Key))
+				float Priority = 0.f;
+				FSwarmPathHandle RepairFrom;
+				for (const FPendingEntity& PE : Members)
 				{
-					if ((Now - *LastT) < GKeySolveCooldown)
-						continue;
-				}
-			}
-			
-			if (!SharedRef)
-			{
-				const FPendingEntity& Rep = *Algo::MinElementBy(Members, &FPendingEntity::DistSq2D);
-				const FVector RepStart = Xforms[Rep.Index].GetTransform().GetTranslation();
+					const FSwarmPathStateFragment& Path = Paths[PE.Index];
+					Priority = FMath::Max(Priority, SwarmPath::RequestPriority(
+						FMath::Sqrt(PE.DistSq2D), Path.PathAge, !Sense[PE.Index].bLOS, Progress[PE.Index].bLikelyStuck));
 
-				if (UNavigationPath* P = NavSys->FindPathToLocationSynchronously(World, RepStart, FinalGoal))
-				{
-					if (P->PathPoints.Num() >= 2 && Prof.RepathsUsed < Params.RepathsPerFrameBudget)
-					{
-						SharedRef = MakeShared<TArray<FVector>>(MoveTemp(P->PathPoints));
-						++Prof.RepathsUsed;
-						GPathCache_RefreshOrInsert(Key, SharedRef, Now);
-						GPathCache_EvictOldestIfNeeded();
-						GLastSolveTime.FindOrAdd(Key) = Now;
-					}
+					// Goal only slipped into a neighbouring cell: the old corridor is still good up to near its end.
+					if (!RepairFrom.IsValid() && Path.bHasPath && SwarmPath::IsNeighborCell(Q3D(Path.LastGoal), PlayerCell))
+						RepairFrom = Path.PathHandle;
 				}
+
+				const FPendingEntity& Rep = *Algo::MinElementBy(Members, &FPendingEntity::DistSq2D);
+				ChunkRequests.Add({ Key, Xforms[Rep.Index].GetTransform().GetTranslation(), FinalGoal, Priority,
+					Rep.DistSq2D > FMath::Square(3000.f), RepairFrom });
+				continue;
 			}
 
-			if (SharedRef)
+			CacheHits.fetch_add(1, std::memory_order_relaxed);
+
+			for (const FPendingEntity& PE : Members)
 			{
-				for (const FPendingEntity& PE : Members)
-				{
-					FSwarmPathStateFragment& Path = Paths[PE.Index];
-					Path.PointsRef = SharedRef;
-					Path.Index     = 1;
-					Path.bHasPath  = true;
-					Path.LastGoal  = FinalGoal;
-					Path.RepathCooldown = ComputeCooldown(FMath::Sqrt(PE.DistSq2D), Exec.GetEntity(PE.Index).AsNumber());
-					Path.PathAge = 0.f;
-					BudgetStamp[PE.Index].bDidReplan = true;
-				}
+				FSwarmPathStateFragment& Path = Paths[PE.Index];
+				Path.SetPath(Pool, Cached, View.Num());
+				Path.Index     = 1;
+				Path.bHasPath  = true;
+				Path.LastGoal  = FinalGoal;
+				Path.RepathCooldown = ComputeCooldown(FMath::Sqrt(PE.DistSq2D), Exec.GetEntity(PE.Index).AsNumber());
+				Path.PathAge = 0.f;
+				BudgetStamp[PE.Index].bDidReplan = true;
 			}
 		}
 
-		Prof.T_PathReplan += (FPlatformTime::Seconds() - T0) * 1000.0;
+		if (ChunkRequests.Num() > 0)
+		{
+			int32 Evictions = 0;
+			RepathsUsed.fetch_add(Scheduler->SubmitBatch(ChunkRequests, Now, &Evictions), std::memory_order_relaxed);
+			CacheEvictions.fetch_add(Evictions, std::memory_order_relaxed);
+		}
+	}, FMassEntityQuery::EParallelExecutionFlags::Force);
+
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
+	{
+		Prof.RepathsUsed        += RepathsUsed.load();
+		Prof.PathCacheHits      += CacheHits.load();
+		Prof.PathCacheMisses    += CacheMisses.load();
+		Prof.PathCacheEvictions += CacheEvictions.load();
+		Prof.T_PathReplan       += (FPlatformTime::Seconds() - T0) * 1000.0;
 	});
 }
@@ -24,4 +24,5 @@ public:
 
 private:
 	FMassEntityQuery Query;
+	FSwarmRoundRobin Schedule;
 };
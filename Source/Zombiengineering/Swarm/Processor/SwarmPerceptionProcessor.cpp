@@ -11,6 +11,40 @@
 #include "MassExecutionContext.h"
 #include "SwarmProcessorCommons.h"
 #include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/Grid/SwarmVisibilityFieldSubsystem.h"
+#include "Swarm/Budget/SwarmBudgetSubsystem.h"
+
+namespace
+{
+	// Cache key for LOS from AgentCell to PlayerCell; slot index comes from the low bits.
+	FORCEINLINE uint32 LOSKey(const FIntPoint& AgentCell, const FIntPoint& PlayerCell)
+	{
+		uint64 k = (uint64(uint16(AgentCell.X)) | (uint64(uint16(AgentCell.Y)) << 16)) |
+			((uint64(uint16(PlayerCell.X)) | (uint64(uint16(PlayerCell.Y)) << 16)) << 32);
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdULL;
+		k ^= k >> 33;
+		return uint32(k) ^ uint32(k >> 32);
+	}
+
+	FORCEINLINE uint64 PackLOS(uint32 Key, uint32 TimeMs, bool bLOS, bool bPending = false)
+	{
+		return uint64(Key) | (uint64((TimeMs + 1) & 0x3FFFFFFFu) << 32) | (uint64(bPending) << 62) | (uint64(bLOS) << 63);
+	}
+
+	// Time of the cached result, or false if the slot is empty or holds another key.
+	FORCEINLINE bool UnpackLOS(uint64 Packed, uint32 Key, uint32& OutTimeMs, bool& bOutLOS, bool& bOutPending)
+	{
+		const uint32 Stamp = uint32(Packed >> 32) & 0x3FFFFFFFu;
+		if (Stamp == 0 || uint32(Packed) != Key)
+			return false;
+
+		OutTimeMs   = Stamp - 1;
+		bOutPending = ((Packed >> 62) & 1) != 0;
+		bOutLOS     = (Packed >> 63) != 0;
+		return true;
+	}
+}
 
 USwarmPerceptionProcessor::USwarmPerceptionProcessor()
 	: Query(*this)
@@ -32,6 +66,8 @@ void USwarmPerceptionProcessor::ConfigureQueries(const TSharedRef<FMassEntityMan
 	Query.AddRequirement<FSwarmBudgetStampFragment>(EMassFragmentAccess::ReadWrite);
 
 	Query.AddRequirement<FSwarmUpdatePolicyFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+	Query.AddChunkRequirement<FSwarmLODChunkFragment>(EMassFragmentAccess::ReadOnly);
 
 	Query.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
 	Query.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
@@ -49,21 +85,26 @@ void USwarmPerceptionProcessor::Execute(FMassEntityManager&, FMassExecutionConte
 
 	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
 
-	const uint32 FrameIdx = (uint32)(World->TimeSeconds * 60.0f);
+	const uint32 NowMs    = uint32(World->TimeSeconds * 1000.0) & 0x3FFFFFFEu;
+
+	std::atomic<int32> Shared{ 0 };
+	std::atomic<int32> FieldHits{ 0 };
+	std::atomic<int32> CacheHits{ 0 };
+	std::atomic<int32> CacheMisses{ 0 };
+	std::atomic<int32> CacheWaits{ 0 };
+
+	const USwarmVisibilityFieldSubsystem* VisSS = World->GetSubsystem<USwarmVisibilityFieldSubsystem>();
+	const bool bHaveField = VisSS && VisSS->HasField();
+
+	USwarmBudgetSubsystem* Budgets = World->GetSubsystem<USwarmBudgetSubsystem>();
 
 	const double T0 = FPlatformTime::Seconds();
 	Query.ParallelForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
 	{
-		FSwarmProfilerSharedFragment& Prof          = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 		const FPlayerSharedFragment& Player         = Exec.GetSharedFragment<FPlayerSharedFragment>();
 		const FSwarmMovementParamsFragment& Params  = Exec.GetSharedFragment<FSwarmMovementParamsFragment>();
 
-		if (LastLOSResetFrame != FrameIdx)
-		{
-			Prof.LOSChecksUsed = 0;
-			LastLOSResetFrame  = FrameIdx;
-		}
-
+		FSwarmBudgetLease Traces(Budgets, ESwarmBudget::LOSTrace);
 
 		const int32 N = Exec.GetNumEntities();
 		auto Xforms      = Exec.GetFragmentView<FTransformFragment>();
@@ -73,18 +114,31 @@ void USwarmPerceptionProcessor::Execute(FMassEntityManager&, FMassExecutionConte
 		auto Policy      = Exec.GetFragmentView<FSwarmUpdatePolicyFragment>();
 
 		const float Dt = Exec.GetDeltaTimeSeconds();
+		const bool  bSenseThisFrame = IsChunkStageDue(Exec, ESwarmLODStage::Sense, GFrameNumber);
 
 		const FVector PlayerLoc    = Player.PlayerLocation;
 		const FVector PlayerNavLoc = Player.PlayerNavLocation;
 		const bool    bPlayerOnNav = Player.bIsOnNavMesh;
 		const FVector ZOffset(0.f, 0.f, Params.LOSHeightOffset);
 		const float   DirectChaseRangeSq = FMath::Square(Params.DirectChaseRange);
+		const float   InvClusterSize = 1.f / FMath::Max(50.f, Params.LOSClusterCellSize);
+		const FVector   PlayerKeyLoc = bPlayerOnNav ? PlayerNavLoc : PlayerLoc;
+		const FIntPoint PlayerCell(FMath::FloorToInt(PlayerKeyLoc.X * InvClusterSize), FMath::FloorToInt(PlayerKeyLoc.Y * InvClusterSize));
+		int32 ChunkShared = 0;
+		int32 ChunkFieldHits = 0;
+		int32 ChunkCacheHits = 0;
+		int32 ChunkCacheMisses = 0;
+		int32 ChunkCacheWaits = 0;
 
 		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SwarmPlayerLOS), false);
 		QueryParams.bReturnPhysicalMaterial = false;
 
-		auto ComputeLOS = [&](const FVector& From) -> bool
+		// Geometry traces are deferred when async traces are on: bOutDeferred is set, the request
+		// queued on the fragment for USwarmLOSTraceSubmitProcessor, and the result lands next frame.
+		auto ComputeLOS = [&](int32 i, const FVector& From, bool& bOutDeferred) -> bool
 		{
+			bOutDeferred = false;
+
 			if (bPlayerOnNav)
 			{
 				FNavLocation FromNav;
@@ -98,6 +152,15 @@ void USwarmPerceptionProcessor::Execute(FMassEntityManager&, FMassExecutionConte
 
 			const FVector Start = From + ZOffset;
 			const FVector End   = PlayerLoc + ZOffset;
+			if (Params.bAsyncLOSTraces)
+			{
+				LOS[i].TraceStart   = FVector3f(Start);
+				LOS[i].TraceEnd     = FVector3f(End);
+				LOS[i].bTraceQueued = true;
+				bOutDeferred = true;
+				return LOS[i].bHasLOS;
+			}
+
 			FHitResult Hit;
 			const bool bHit = World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, QueryParams);
 			return (!bHit || Hit.GetActor() == PlayerPawn);
@@ -113,43 +176,137 @@ void USwarmPerceptionProcessor::Execute(FMassEntityManager&, FMassExecutionConte
 
 			LOS[i].TimeSinceRefresh += Dt;
 
-			const bool bSenseThisFrame  = ((FrameIdx & Policy[i].SenseMask) == 0);
+			const FIntPoint Cell(FMath::FloorToInt(MyLoc.X * InvClusterSize), FMath::FloorToInt(MyLoc.Y * InvClusterSize));
+			const uint32    Key = LOSKey(Cell, PlayerCell);
+			std::atomic<uint64>* Cached = Params.bClusteredLOS ? &LOSCache[Key & uint32(NumLOSCacheSlots - 1)] : nullptr;
+
+			// Last frame's async trace; results only live one frame, so consumed or not it's done.
+			if (LOS[i].PendingTrace.IsValid())
+			{
+				FTraceDatum Datum;
+				if (World->QueryTraceData(LOS[i].PendingTrace, Datum))
+				{
+					const FHitResult* Hit = Datum.OutHits.Num() > 0 ? &Datum.OutHits[0] : nullptr;
+					const bool bClear = !Hit || !Hit->bBlockingHit || Hit->GetActor() == PlayerPawn;
+
+					LOS[i].bHasLOS          = bClear;
+					LOS[i].TimeSinceRefresh = Dt;
+					Stamp[i].bDidLOSRefresh = true;
+
+					if (Cached)
+						Cached->store(PackLOS(Key, NowMs, bClear), std::memory_order_relaxed);
+				}
+				LOS[i].PendingTrace = FTraceHandle();
+			}
+
 			const bool bInChaseRange    = (Policy[i].DistToPlayer2D_Sq <= DirectChaseRangeSq);
 
+			// The visibility field answers by lookup, every frame, for agents standing near their
+			// cell's raycast sample; tracing is left for what it can't answer.
+			bool bFieldVisible = false;
+			if (bInChaseRange && bHaveField && Params.bUseVisibilityField && VisSS->SampleVisibility(MyLoc, bFieldVisible))
+			{
+				LOS[i].TimeSinceRefresh = 0.f;
+				LOS[i].bHasLOS          = bFieldVisible;
+				Stamp[i].bDidLOSRefresh = true;
+				Sense[i].bLOS           = bFieldVisible;
+				Sense[i].bLOSUpdated    = true;
+				++ChunkFieldHits;
+				continue;
+			}
+
 			if (!bSenseThisFrame || !bInChaseRange)
 			{
 				Sense[i].bLOS        = LOS[i].bHasLOS;
-				Sense[i].bLOSUpdated = false;
+				Sense[i].bLOSUpdated = Stamp[i].bDidLOSRefresh;
 				continue;
 			}
 
 			const uint32 H      = GetTypeHash(Exec.GetEntity(i));
 			const float  Phase  = (H & 0xFF) * (Params.LOSRefreshSeconds / 256.f);
-			const bool   bDue   = (LOS[i].TimeSinceRefresh + Phase >= Params.LOSRefreshSeconds);
+			bool         bDue   = (LOS[i].TimeSinceRefresh + Phase >= Params.LOSRefreshSeconds);
 			bool         bLOSNow = LOS[i].bHasLOS;
 
-			if (bDue && (Prof.LOSChecksUsed < Params.LOSChecksPerFrameBudget))
+			// Agents in the same cell share traces while the player stays in the same cell. A cached
+			// result within its TTL stands in for a due trace and is adopted early whenever it is
+			// newer than our own; the first due agent that misses traces for the whole cell. Taking one
+			// restarts our refresh interval, or a TTL longer than it would leave us due every frame.
+			// While another agent's async trace for the cell is in flight, due agents wait a frame
+			// for it instead of queuing the same trace; a marker older than a refresh is ignored.
+			uint32 CachedMs = 0;
+			bool   bCachedLOS = false;
+			bool   bCachePending = false;
+			bool   bCacheValid = false;
+			if (Cached && UnpackLOS(Cached->load(std::memory_order_relaxed), Key, CachedMs, bCachedLOS, bCachePending))
+			{
+				const float CachedAge = (NowMs - CachedMs) * 0.001f;
+				if (bCachePending)
+				{
+					if (bDue && CachedAge < Params.LOSRefreshSeconds)
+					{
+						++ChunkCacheWaits;
+						bDue = false;
+					}
+				}
+				else
+				{
+					bCacheValid = CachedAge < Params.LOSCacheTTL;
+				}
+
+				if (bCacheValid && (bDue || CachedAge < LOS[i].TimeSinceRefresh))
+				{
+					LOS[i].TimeSinceRefresh = 0.f;
+					LOS[i].bHasLOS = bLOSNow = bCachedLOS;
+					Stamp[i].bDidLOSRefresh = true;
+					if (bDue)
+						++ChunkCacheHits;
+					else
+						++ChunkShared;
+					bDue = false;
+				}
+			}
+			if (bDue && Cached && !bCacheValid)
+				++ChunkCacheMisses;
+
+			if (bDue && Traces.TryConsume())
 			{
-				++Prof.LOSChecksUsed;
 				LOS[i].TimeSinceRefresh = 0.f;
 
-				bLOSNow = ComputeLOS(MyLoc);
-				LOS[i].bHasLOS = bLOSNow;
-				Stamp[i].bDidLOSRefresh = true;
+				bool bDeferred = false;
+				bLOSNow = ComputeLOS(i, MyLoc, bDeferred);
+				if (!bDeferred)
+				{
+					LOS[i].bHasLOS = bLOSNow;
+					Stamp[i].bDidLOSRefresh = true;
+
+					if (Cached)
+						Cached->store(PackLOS(Key, NowMs, bLOSNow), std::memory_order_relaxed);
+				}
+				else if (Cached)
+				{
+					Cached->store(PackLOS(Key, NowMs, bLOSNow, true), std::memory_order_relaxed);
+				}
 			}
 
 			Sense[i].bLOS        = bLOSNow;
 			Sense[i].bLOSUpdated = Stamp[i].bDidLOSRefresh;
 		}
 
+		Shared.fetch_add(ChunkShared, std::memory_order_relaxed);
+		FieldHits.fetch_add(ChunkFieldHits, std::memory_order_relaxed);
+		CacheHits.fetch_add(ChunkCacheHits, std::memory_order_relaxed);
+		CacheMisses.fetch_add(ChunkCacheMisses, std::memory_order_relaxed);
+		CacheWaits.fetch_add(ChunkCacheWaits, std::memory_order_relaxed);
 	}, FMassEntityQuery::EParallelExecutionFlags::Force);
 
-	bool b = false;
-	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
 	{
-		if (b) return;
-		FSwarmProfilerSharedFragment& Prof         = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 		Prof.T_Perception = (FPlatformTime::Seconds() - T0) * 1000.0;
-		b = true;
+		Prof.LOSShared   += Shared.load();
+		Prof.LOSFieldHits += FieldHits.load();
+		Prof.LOSCacheHits   += CacheHits.load();
+		Prof.LOSCacheMisses += CacheMisses.load();
+		Prof.LOSCacheWaits  += CacheWaits.load();
+		Prof.LOSChecksUsed = Budgets ? Budgets->GetUsed(ESwarmBudget::LOSTrace) : 0;
 	});
 }
@@ -3,6 +3,8 @@
 #include "MassProcessor.h"
 #include "MassExecutionContext.h"
 
+#include <atomic>
+
 #include "SwarmPerceptionProcessor.generated.h"
 
 UCLASS()
@@ -18,5 +20,10 @@ public:
 private:
 	FMassEntityQuery Query;
 
-	uint32 LastLOSResetFrame = 0;
+	// Newest LOS result per (agent cell, player cell), packed as
+	// [key hash:32 | time ms + 1:30 | pending:1 | los:1]. Pending marks an async trace queued for
+	// the cell whose result hasn't landed yet. Direct-mapped by the key hash; a colliding key
+	// just overwrites.
+	static constexpr int32 NumLOSCacheSlots = 8192;
+	std::atomic<uint64> LOSCache[NumLOSCacheSlots] = {};
 };
@@ -1,6 +1,9 @@
 #pragma once
 #include "MassExecutionContext.h"
+#include "MassEntityQuery.h"
 #include "CoreMinimal.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/LOD/SwarmLODControllerSubsystem.h"
 
 namespace SwarmGroups
 {
@@ -28,7 +31,98 @@ struct FSwarmScopedTimer
 	}
 };
 
-static FORCEINLINE bool ShouldProcessChunkThisFrame(const FMassExecutionContext& Exec, uint32 N = 2)
+// Runs Fn once with the swarm's profiler fragment. Every agent shares the same one, so the
+// first matching chunk is enough; the query must require it ReadWrite.
+template<typename TFunc>
+static FORCEINLINE void WithSwarmProfiler(FMassEntityQuery& Query, FMassExecutionContext& Context, TFunc&& Fn)
 {
-	return (GFrameNumber % N) == (GetTypeHash(Exec.GetEntity(0)) % N);
+	bool bDone = false;
+	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	{
+		if (bDone) return;
+		bDone = true;
+		Fn(Exec, Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>());
+	});
+}
+
+// Spreads a stage that visits each agent once every Divisor frames evenly over those frames.
+// Begin lays the query's chunks end to end and stores each chunk's offset in its
+// FSwarmScheduleChunkFragment, which gives every agent a slot. Frame k of the cycle takes
+// slots [k * Slice, (k + 1) * Slice) with Slice = ceil(Total / Divisor). That window lands as
+// one contiguous entity range in each chunk it touches. Slots hold as long as the chunk layout
+// does. The query must require FSwarmScheduleChunkFragment ReadWrite.
+class FSwarmRoundRobin
+{
+public:
+	// Before the chunk pass, on the same query. Touches chunks only, not entities.
+	void Begin(FMassEntityQuery& Query, FMassExecutionContext& Context, ESwarmSchedule InSchedule, uint32 InDivisor)
+	{
+		Schedule = InSchedule;
+		Divisor  = FMath::Max(1u, InDivisor);
+		Round    = GFrameNumber / Divisor;
+
+		int32 Total = 0;
+		Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+		{
+			Exec.GetMutableChunkFragment<FSwarmScheduleChunkFragment>().Base[uint8(Schedule)] = Total;
+			Total += Exec.GetNumEntities();
+		});
+
+		const int32 Slice = FMath::DivideAndRoundUp(Total, int32(Divisor));
+		WindowBegin = int32(GFrameNumber % Divisor) * Slice;
+		WindowEnd   = FMath::Min(Total, WindowBegin + Slice);
+	}
+
+	// This chunk's part of the frame's window, as entity indices [OutBegin, OutEnd).
+	bool GetChunkRange(const FMassExecutionContext& Exec, int32& OutBegin, int32& OutEnd) const
+	{
+		const int32 Base = Exec.GetChunkFragment<FSwarmScheduleChunkFragment>().Base[uint8(Schedule)];
+
+		OutBegin = FMath::Max(WindowBegin - Base, 0);
+		OutEnd   = FMath::Min(WindowEnd - Base, Exec.GetNumEntities());
+		return OutBegin < OutEnd;
+	}
+
+	// Completed cycles. An agent is visited once per round, so per-tier decimation counts rounds.
+	FORCEINLINE uint32 GetRound() const { return Round; }
+
+private:
+	ESwarmSchedule Schedule = ESwarmSchedule::UpdatePolicy;
+	uint32 Divisor     = 1;
+	uint32 Round       = 0;
+	int32  WindowBegin = 0;
+	int32  WindowEnd   = 0;
+};
+
+// Tier tags partition archetypes, so one answer holds for the whole chunk.
+static FORCEINLINE ESwarmLODTier GetChunkLODTier(const FMassExecutionContext& Exec)
+{
+	if (Exec.DoesArchetypeHaveTag<FSwarmLODFarTag>()) return ESwarmLODTier::Far;
+	if (Exec.DoesArchetypeHaveTag<FSwarmLODMidTag>()) return ESwarmLODTier::Mid;
+	return ESwarmLODTier::Near;
+}
+
+// Frame counter offset by the chunk's phase, so chunks of a decimated tier spread over frames.
+// Queries reading it need FSwarmLODChunkFragment as a chunk requirement.
+static FORCEINLINE uint32 GetChunkFrame(const FMassExecutionContext& Exec, uint32 FrameIdx)
+{
+	return FrameIdx + Exec.GetChunkFragment<FSwarmLODChunkFragment>().Phase;
+}
+
+static FORCEINLINE uint8 GetChunkStageMask(const FMassExecutionContext& Exec, ESwarmLODStage Stage)
+{
+	return Exec.GetChunkFragment<FSwarmLODChunkFragment>().StageMask[uint8(Stage)];
+}
+
+static FORCEINLINE bool IsChunkStageDue(const FMassExecutionContext& Exec, ESwarmLODStage Stage, uint32 FrameIdx)
+{
+	return (GetChunkFrame(Exec, FrameIdx) & GetChunkStageMask(Exec, Stage)) == 0;
+}
+
+// Chunk filter for stages whose off-frame chunks have nothing to do. Frames count in rounds of
+// Divisor, as FSwarmRoundRobin does, so a chunk is in or out for a whole round.
+template<ESwarmLODStage Stage, uint32 Divisor>
+static bool ShouldRunSwarmChunk(const FMassExecutionContext& Exec)
+{
+	return IsChunkStageDue(Exec, Stage, GFrameNumber / Divisor);
 }
\ No newline at end of file
@@ -1,11 +1,39 @@
 #include "SwarmUpdatePolicyProcessor.h"
 
 #include "MassCommonFragments.h"
+#include "MassCommandBuffer.h"
 #include "HAL/PlatformTime.h"
 #include "Swarm/Grid/SwarmGridSubsystem.h"
 #include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/LOD/SwarmLODControllerSubsystem.h"
 #include "SwarmProcessorCommons.h"
 
+namespace
+{
+	template<typename TFrom>
+	void SwapTierTagFrom(FMassCommandBuffer& Cmd, const FMassEntityHandle Entity, ESwarmLODTier To)
+	{
+		switch (To)
+		{
+		case ESwarmLODTier::Near: Cmd.SwapTags<TFrom, FSwarmLODNearTag>(Entity); break;
+		case ESwarmLODTier::Mid:  Cmd.SwapTags<TFrom, FSwarmLODMidTag>(Entity);  break;
+		case ESwarmLODTier::Far:  Cmd.SwapTags<TFrom, FSwarmLODFarTag>(Entity);  break;
+		default: break;
+		}
+	}
+
+	void SwapTierTag(FMassCommandBuffer& Cmd, const FMassEntityHandle Entity, ESwarmLODTier From, ESwarmLODTier To)
+	{
+		switch (From)
+		{
+		case ESwarmLODTier::Near: SwapTierTagFrom<FSwarmLODNearTag>(Cmd, Entity, To); break;
+		case ESwarmLODTier::Mid:  SwapTierTagFrom<FSwarmLODMidTag>(Cmd, Entity, To);  break;
+		case ESwarmLODTier::Far:  SwapTierTagFrom<FSwarmLODFarTag>(Cmd, Entity, To);  break;
+		default: break;
+		}
+	}
+}
+
 USwarmUpdatePolicyProcessor::USwarmUpdatePolicyProcessor()
 	: Query(*this)
 {
@@ -27,6 +55,8 @@ void USwarmUpdatePolicyProcessor::ConfigureQueries(const TSharedRef<FMassEntityM
 {
 	Query.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
 	Query.AddRequirement<FSwarmUpdatePolicyFragment>(EMassFragmentAccess::ReadWrite);
+	Query.AddTagRequirement<FSwarmDormantTag>(EMassFragmentPresence::None);
+	Query.AddChunkRequirement<FSwarmScheduleChunkFragment>(EMassFragmentAccess::ReadWrite);
 
 	Query.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
 	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
@@ -40,6 +70,9 @@ void USwarmUpdatePolicyProcessor::Execute(FMassEntityManager&, FMassExecutionCon
 	USwarmGridSubsystem* GridSS = World->GetSubsystem<USwarmGridSubsystem>();
 	if (!GridSS) return;
 
+	const USwarmLODControllerSubsystem* LOD = World->GetSubsystem<USwarmLODControllerSubsystem>();
+	if (!LOD) return;
+
 	const bool  bGridEmpty = GridSS->IsGridEmpty();
 	const float CellSize   = GridSS->GetCellSize();
 
@@ -47,26 +80,24 @@ void USwarmUpdatePolicyProcessor::Execute(FMassEntityManager&, FMassExecutionCon
 	const float CountRadius   = 0.6f * CellSize;
 	const float ZHalfHeight   = 120.f;
 
-	const float NearSq = FMath::Square(1500.f);
-	const float FarSq  = FMath::Square(4000.f);
-
 	const float Dense     = 3.0f;
 	const float VeryDense = 6.0f;
 
 	const double T0 = FPlatformTime::Seconds();
-	
+
+	Schedule.Begin(Query, Context, ESwarmSchedule::UpdatePolicy, 30);
 	Query.ParallelForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
 	{
-		if (!ShouldProcessChunkThisFrame(Exec, 30))
+		int32 Begin = 0, End = 0;
+		if (!Schedule.GetChunkRange(Exec, Begin, End))
 			return;
-		
+
 		const FPlayerSharedFragment& Player = Exec.GetSharedFragment<FPlayerSharedFragment>();
 
-		const int32 N = Exec.GetNumEntities();
 		auto Transforms   = Exec.GetFragmentView<FTransformFragment>();
 		auto Policy   = Exec.GetMutableFragmentView<FSwarmUpdatePolicyFragment>();
 
-		for (int32 i = 0; i < N; ++i)
+		for (int32 i = Begin; i < End; ++i)
 		{
 			const FVector P   = Transforms[i].GetTransform().GetLocation();
 			const float   d2  = FVector::DistSquared2D(P, Player.PlayerLocation);
@@ -78,55 +109,46 @@ void USwarmUpdatePolicyProcessor::Execute(FMassEntityManager&, FMassExecutionCon
 			}
 			const float Density = (CountInArea > 0) ? (CountInArea / AreaM2PerCell) : 0.0f;
 
-			uint8 FlockMask  = 0;
-			uint8 FollowMask = 0;
-			uint8 SenseMask  = 0;
+			// Stages read their tier's rates from the LOD controller per chunk; crowding can only
+			// slow separation further, and that part stays per entity.
+			FSwarmUpdatePolicyFragment& Out = Policy[i];
+			const ESwarmLODTier OldTier = ESwarmLODTier(Out.Tier);
+			const ESwarmLODTier Tier    = LOD->TierFor(d2, OldTier);
+			if (Tier != OldTier)
+				SwapTierTag(Exec.Defer(), Exec.GetEntity(i), OldTier, Tier);
+
+			uint8 FlockMask = LOD->GetMask(ESwarmLODStage::Separation, Tier);
 
 			if      (Density >= VeryDense)
 			{
-				FlockMask = 0x3;
+				FlockMask = FMath::Max<uint8>(FlockMask, 0x3);
 			}
 			else if (Density >= Dense)
 			{
-				FlockMask = 0x1;
-			}
-
-			if      (d2 >= FarSq)
-			{
-				FollowMask = 0x3; SenseMask = 0x7;
-			}
-			else if (d2 >= NearSq)
-			{
-				FollowMask = 0x1; SenseMask = 0x1;
+				FlockMask = FMath::Max<uint8>(FlockMask, 0x1);
 			}
 
 			float CooldownScale = 1.0f;
-			if (d2 >= NearSq)
+			if (Tier != ESwarmLODTier::Near)
 			{
-				CooldownScale *= (d2 >= FarSq ? 2.0f : 1.5f);
+				CooldownScale *= (Tier == ESwarmLODTier::Far ? 2.0f : 1.5f);
 			}
 			if (Density >= VeryDense)
 			{
 				CooldownScale *= 1.5f;
 			}
 
-			FSwarmUpdatePolicyFragment& Out = Policy[i];
 			Out.DistToPlayer2D_Sq = d2;
 			Out.EstimatedDensity  = Density;
 			Out.CooldownScale     = CooldownScale;
-			Out.SeparationMask         = FlockMask;
-			Out.FollowMask        = FollowMask;
-			Out.SenseMask         = SenseMask;
+			Out.SeparationMask    = FlockMask;
+			Out.Tier              = uint8(Tier);
 		}
 
 	}, FMassEntityQuery::EParallelExecutionFlags::Force);
 
-	bool b = false;
-	Query.ForEachEntityChunk(Context, [&](FMassExecutionContext& Exec)
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
 	{
-		if (b) return;
-		FSwarmProfilerSharedFragment& Prof  = Exec.GetMutableSharedFragment<FSwarmProfilerSharedFragment>();
 		Prof.T_UpdatePolicy = (FPlatformTime::Seconds() - T0) * 1000.0;
-		b = true;
 	});
 }
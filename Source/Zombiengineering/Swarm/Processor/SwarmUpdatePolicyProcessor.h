@@ -2,6 +2,7 @@
 
 #include "MassProcessor.h"
 #include "MassExecutionContext.h"
+#include "SwarmProcessorCommons.h"
 
 #include "SwarmUpdatePolicyProcessor.generated.h"
 
@@ -17,4 +18,5 @@ public:
 
 private:
 	FMassEntityQuery Query;
+	FSwarmRoundRobin Schedule;
 };
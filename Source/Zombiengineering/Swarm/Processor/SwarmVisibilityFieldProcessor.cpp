@@ -0,0 +1,57 @@
+#include "SwarmVisibilityFieldProcessor.h"
+
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "MassCommonTypes.h"
+#include "SwarmProcessorCommons.h"
+#include "Swarm/Fragment/SwarmTypes.h"
+#include "Swarm/Grid/SwarmVisibilityFieldSubsystem.h"
+
+USwarmVisibilityFieldProcessor::USwarmVisibilityFieldProcessor()
+	: Query(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionOrder.ExecuteInGroup = SwarmGroups::PrePass;
+	ExecutionOrder.ExecuteAfter.Add(SwarmGroups::Prepare);
+	ExecutionOrder.ExecuteBefore.Add(SwarmGroups::Sense);
+	bRequiresGameThreadExecution = true;
+
+	RegisterQuery(Query);
+}
+
+void USwarmVisibilityFieldProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>&)
+{
+	Query.AddSharedRequirement<FSwarmMovementParamsFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddSharedRequirement<FPlayerSharedFragment>(EMassFragmentAccess::ReadOnly);
+	Query.AddSharedRequirement<FSwarmProfilerSharedFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USwarmVisibilityFieldProcessor::Execute(FMassEntityManager&, FMassExecutionContext& Context)
+{
+	UWorld* World = Context.GetWorld();
+	if (!World) return;
+
+	USwarmVisibilityFieldSubsystem* VisSS = World->GetSubsystem<USwarmVisibilityFieldSubsystem>();
+	if (!VisSS) return;
+
+	const double T0 = FPlatformTime::Seconds();
+
+	WithSwarmProfiler(Query, Context, [&](FMassExecutionContext& Exec, FSwarmProfilerSharedFragment& Prof)
+	{
+		const FSwarmMovementParamsFragment& Params = Exec.GetSharedFragment<FSwarmMovementParamsFragment>();
+		const FPlayerSharedFragment& Player        = Exec.GetSharedFragment<FPlayerSharedFragment>();
+
+		// Off the navmesh perception traces geometry instead, which the field can't stand in for.
+		if (!Params.bUseVisibilityField || !Player.bIsOnNavMesh)
+		{
+			if (VisSS->HasField())
+				VisSS->Reset();
+			return;
+		}
+
+		int32 Queries = 0;
+		VisSS->Tick(Player.PlayerNavLocation, Queries);
+
+		Prof.T_VisField += (FPlatformTime::Seconds() - T0) * 1000.0;
+	});
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "MassProcessor.h"
+#include "SwarmVisibilityFieldProcessor.generated.h"
+
+UCLASS()
+class USwarmVisibilityFieldProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USwarmVisibilityFieldProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>&) override;
+	virtual void Execute(FMassEntityManager&, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery Query;
+};
@@ -26,6 +26,12 @@ void USwarmTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, c
 	
 	BuildContext.AddFragment<FMassActorFragment>();
 	BuildContext.AddFragment<FAgentRadiusFragment>();
+	BuildContext.AddFragment<FSwarmDormancyFragment>();
+	BuildContext.AddChunkFragment<FSwarmLODChunkFragment>();
+	BuildContext.AddChunkFragment<FSwarmScheduleChunkFragment>();
+
+	// Matches FSwarmUpdatePolicyFragment's default tier until the policy first sees the agent.
+	BuildContext.AddTag<FSwarmLODNearTag>();
 	
 	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
 